@@ -14,12 +14,18 @@
 
 #include <cassert>
 
+#include "spark_wiring_fd_stream.h"
 #include "spark_wiring_flags.h"
+#include "spark_wiring_format.h"
 #include "spark_wiring_json.h"
 #include "spark_wiring_ledger.h"
 #include "spark_wiring_map.h"
+#include "spark_wiring_serial_pair.h"
+#include "spark_wiring_small_vector.h"
 #include "spark_wiring_stream.h"
 #include "spark_wiring_string.h"
+#include "spark_wiring_string_builder.h"
+#include "spark_wiring_string_pool.h"
 #include "spark_wiring_time.h"
 #include "spark_wiring_variant.h"
 #include "spark_wiring_vector.h"
@@ -116,33 +122,45 @@ public:
         vprintf(level, fmt, ap);
         va_end(ap);
     }
-    
+
+    /*!
+        \brief Generates trace, info, warning, error or arbitrary level message.
+        \param fmt Format string defined with PARTICLE_FMT().
+
+        The message is formatted with spark::format() directly to the output.
+    */
+    template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<spark::detail::IsFormatString<FormatT>::value>>
+    void trace(FormatT fmt, const ArgsT&... args) const {
+        log(LOG_LEVEL_TRACE, fmt, args...);
+    }
+
+    template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<spark::detail::IsFormatString<FormatT>::value>>
+    void info(FormatT fmt, const ArgsT&... args) const {
+        log(LOG_LEVEL_INFO, fmt, args...);
+    }
+
+    template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<spark::detail::IsFormatString<FormatT>::value>>
+    void warn(FormatT fmt, const ArgsT&... args) const {
+        log(LOG_LEVEL_WARN, fmt, args...);
+    }
+
+    template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<spark::detail::IsFormatString<FormatT>::value>>
+    void error(FormatT fmt, const ArgsT&... args) const {
+        log(LOG_LEVEL_ERROR, fmt, args...);
+    }
+
+    template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<spark::detail::IsFormatString<FormatT>::value>>
+    void log(LogLevel level, FormatT fmt, const ArgsT&... args) const {
+        StdoutPrint out;
+        ::printf("%s %s: ", name.c_str(), levelName(level));
+        spark::format(out, fmt, args...);
+        ::printf("\n");
+    }
+
     void vprintf(LogLevel level, const char *fmt, va_list ap) const {
         char buf[512];
         vsnprintf(buf, sizeof(buf), fmt, ap);
-        const char *levelStr;
-        switch(level) {
-            case LOG_LEVEL_TRACE:
-                levelStr = "TRACE";
-                break;
-            case LOG_LEVEL_INFO:
-                levelStr = "INFO";
-                break;
-            case LOG_LEVEL_WARN:
-                levelStr = "WARN";
-                break;
-            case LOG_LEVEL_ERROR:
-                levelStr = "ERROR";
-                break;
-            case LOG_LEVEL_PANIC:
-                levelStr = "PANIC";
-                break; 
-            default:
-                levelStr = "UNKNOWN";
-                break;               
-        }
-
-        ::printf("%s %s: %s\n", name.c_str(), levelStr, buf);
+        ::printf("%s %s: %s\n", name.c_str(), levelName(level), buf);
     }
 
     void write(const char *data, size_t size) const {
@@ -185,6 +203,35 @@ public:
     }
 
     String name;
+
+private:
+    class StdoutPrint: public Print {
+    public:
+        size_t write(uint8_t b) override {
+            return fwrite(&b, 1, 1, stdout);
+        }
+
+        size_t write(const uint8_t *data, size_t size) override {
+            return fwrite(data, 1, size, stdout);
+        }
+    };
+
+    static const char* levelName(LogLevel level) {
+        switch(level) {
+            case LOG_LEVEL_TRACE:
+                return "TRACE";
+            case LOG_LEVEL_INFO:
+                return "INFO";
+            case LOG_LEVEL_WARN:
+                return "WARN";
+            case LOG_LEVEL_ERROR:
+                return "ERROR";
+            case LOG_LEVEL_PANIC:
+                return "PANIC";
+            default:
+                return "UNKNOWN";
+        }
+    }
 };
 
 class LogCategoryFilter {
@@ -225,7 +272,12 @@ inline const char* LogCategoryFilter::category() const {
 inline LogLevel LogCategoryFilter::level() const {
     return level_;
 }
+// Define PARTICLE_LOG_CATEGORY_FILTERS_INLINE_CAPACITY to store that many filters without allocating memory
+#ifdef PARTICLE_LOG_CATEGORY_FILTERS_INLINE_CAPACITY
+typedef SmallVector<LogCategoryFilter, PARTICLE_LOG_CATEGORY_FILTERS_INLINE_CAPACITY> LogCategoryFilters;
+#else
 typedef Vector<LogCategoryFilter> LogCategoryFilters;
+#endif
 
 // spark_wiring_logging.h
 
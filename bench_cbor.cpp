@@ -0,0 +1,113 @@
+#include "Particle.h"
+
+#include <chrono>
+#include <string>
+
+// make bench_cbor && ./bench_cbor
+//
+// Measures the throughput of decodeFromCBOR() from a stream that only implements the per-byte
+// interface, and from a stream that overrides Stream::readAvailable()
+
+using namespace particle;
+
+namespace {
+
+class ByteStream: public Stream {
+public:
+    explicit ByteStream(const std::string& data) :
+            data_(data),
+            pos_(0) {
+    }
+
+    int available() override {
+        return data_.size() - pos_;
+    }
+
+    int read() override {
+        return (pos_ < data_.size()) ? (uint8_t)data_[pos_++] : -1;
+    }
+
+    int peek() override {
+        return (pos_ < data_.size()) ? (uint8_t)data_[pos_] : -1;
+    }
+
+    void flush() override {
+    }
+
+    size_t write(uint8_t b) override {
+        return 0;
+    }
+
+protected:
+    const std::string& data_;
+    size_t pos_;
+};
+
+class BulkStream: public ByteStream {
+public:
+    using ByteStream::ByteStream;
+
+    size_t readAvailable(uint8_t* buffer, size_t length) override {
+        const size_t n = std::min(length, data_.size() - pos_);
+        memcpy(buffer, data_.data() + pos_, n);
+        pos_ += n;
+        return n;
+    }
+};
+
+class StringPrint: public Print {
+public:
+    std::string data;
+
+    size_t write(uint8_t b) override {
+        data.push_back(b);
+        return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) override {
+        data.append((const char*)buffer, size);
+        return size;
+    }
+};
+
+template<typename StreamT>
+bool bench(const char* name, const std::string& cbor, const Variant& expected) {
+    const int ROUNDS = 20;
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        StreamT stream(cbor);
+        Variant v;
+        if (decodeFromCBOR(v, stream) != 0 || (i == 0 && v != expected)) {
+            printf("%s: decoding failed\n", name);
+            return false;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    const double sec = std::chrono::duration<double>(t2 - t1).count();
+    printf("%s: %.1f MB/s\n", name, cbor.size() * ROUNDS / sec / 1e6);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Variant v;
+    for (int i = 0; i < 20000; ++i) {
+        Variant rec;
+        rec.set("id", i);
+        rec.set("name", String::format("device-%08d-with-a-longer-name", i));
+        rec.set("payload", String(std::string(200, 'a' + i % 26).c_str()));
+        rec.set("value", i * 0.5);
+        v.append(rec);
+    }
+    StringPrint out;
+    if (encodeToCBOR(v, out) != 0) {
+        printf("encoding failed\n");
+        return 1;
+    }
+    printf("CBOR data: %u bytes\n", (unsigned)out.data.size());
+    if (!bench<ByteStream>("per-byte stream", out.data, v) || !bench<BulkStream>("bulk stream", out.data, v)) {
+        return 1;
+    }
+    return 0;
+}
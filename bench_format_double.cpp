@@ -0,0 +1,58 @@
+#include "Particle.h"
+#include "string_convert.h"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// make bench_format_double && ./bench_format_double
+//
+// Measures the time it takes to format a double in fixed-point notation with snprintf("%.*f") and
+// formatDouble()
+
+using particle::detail::formatDouble;
+
+namespace {
+
+volatile size_t sink = 0;
+
+template<typename FormatFn>
+double nsPerCall(const std::vector<double>& values, FormatFn fn) {
+    const int ROUNDS = 1000;
+    char buf[64];
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; ++i) {
+        for (double v: values) {
+            sink += fn(v, buf, sizeof(buf));
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t2 - t1).count() / (ROUNDS * values.size());
+}
+
+void bench(const char* name, const std::vector<double>& values, unsigned precision) {
+    const double t1 = nsPerCall(values, [precision](double v, char* buf, size_t size) {
+        return (size_t)snprintf(buf, size, "%.*f", (int)precision, v);
+    });
+    const double t2 = nsPerCall(values, [precision](double v, char* buf, size_t size) {
+        return formatDouble(v, precision, buf, size);
+    });
+    printf("%s, precision %u: snprintf %.1f ns, formatDouble %.1f ns\n", name, precision, t1, t2);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::mt19937_64 rng(1);
+    std::vector<double> values;
+    std::vector<double> small;
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back((double)(int64_t)(rng() % 2000000000 - 1000000000) / (1 + rng() % 10000));
+        small.push_back(std::ldexp((double)(rng() >> 11), -60 - (int)(rng() % 10)));
+    }
+    bench("values below 1e6", values, 2);
+    bench("values below 1e6", values, 6);
+    bench("values below 2^-8", small, 6);
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "Particle.h"
+
+#include <chrono>
+
+// make bench_vector && ./bench_vector
+//
+// Measures the time it takes to append 1e6 elements to a Vector one by one, using the default
+// capacity growth policy and an allocator that grows the capacity to exactly the required size
+
+namespace {
+
+struct ExactGrowthAllocator: spark::DefaultAllocator {
+    static int growCapacity(int capacity, int required) {
+        return required;
+    }
+};
+
+template<typename VectorT>
+void bench(const char* name, int count) {
+    auto t1 = std::chrono::steady_clock::now();
+    VectorT v;
+    int capacity = 0;
+    int reallocs = 0;
+    for (int i = 0; i < count; ++i) {
+        v.append(i);
+        if (v.capacity() != capacity) {
+            capacity = v.capacity();
+            ++reallocs;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    printf("%s: %d elements, %d reallocations, %lld us\n", name, v.size(), reallocs,
+            (long long)std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count());
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int COUNT = 1000000;
+    bench<Vector<int>>("default growth", COUNT);
+    bench<Vector<int, ExactGrowthAllocator>>("exact growth", COUNT);
+    return 0;
+}
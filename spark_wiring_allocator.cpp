@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_allocator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+namespace spark {
+
+namespace {
+
+using detail::BlockHeader;
+
+const size_t ALIGNMENT = alignof(std::max_align_t);
+
+inline size_t alignSize(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+inline BlockHeader* blockHeader(void* ptr) {
+    return (BlockHeader*)ptr - 1;
+}
+
+inline void* blockData(BlockHeader* h) {
+    return h + 1;
+}
+
+inline bool isValidSize(size_t size) {
+    return size <= SIZE_MAX / 2;
+}
+
+// Smallest block size used by CachingAllocator, including the block header
+const size_t MIN_CACHED_SIZE = 32;
+const unsigned CACHED_SIZE_CLASS_COUNT = 8; // 32, 64, ..., 4096
+
+static_assert((MIN_CACHED_SIZE << (CACHED_SIZE_CLASS_COUNT - 1)) == CachingAllocator::MAX_CACHED_SIZE,
+        "Invalid number of size classes");
+
+inline unsigned cachedSizeClass(size_t size) {
+    unsigned i = 0;
+    while ((MIN_CACHED_SIZE << i) < size) {
+        ++i;
+    }
+    return i;
+}
+
+struct BlockCache {
+    BlockHeader* blocks[CACHED_SIZE_CLASS_COUNT];
+    unsigned count[CACHED_SIZE_CLASS_COUNT];
+    bool disabled;
+};
+
+// The cache itself is trivially destructible so that it remains accessible while other thread-local
+// objects are being destroyed. The guard object releases the cached blocks when the thread exits
+thread_local BlockCache t_cache = {};
+
+struct BlockCacheGuard {
+    ~BlockCacheGuard() {
+        t_cache.disabled = true;
+        for (unsigned i = 0; i < CACHED_SIZE_CLASS_COUNT; ++i) {
+            auto h = t_cache.blocks[i];
+            while (h) {
+                auto next = *(BlockHeader**)blockData(h);
+                ::free(h);
+                h = next;
+            }
+            t_cache.blocks[i] = nullptr;
+            t_cache.count[i] = 0;
+        }
+    }
+};
+
+inline void initBlockCacheGuard() {
+    static thread_local BlockCacheGuard guard;
+    (void)guard;
+}
+
+} // namespace
+
+// spark::Arena
+struct alignas(std::max_align_t) Arena::Chunk {
+    Chunk* next;
+    size_t size;
+};
+
+thread_local Arena* Arena::s_current = nullptr;
+
+Arena::Arena(size_t chunkSize) :
+        chunks_(nullptr),
+        ptr_(nullptr),
+        end_(nullptr),
+        chunkSize_(alignSize(chunkSize)),
+        allocSize_(0) {
+}
+
+Arena::~Arena() {
+    while (chunks_) {
+        auto next = chunks_->next;
+        ::free(chunks_);
+        chunks_ = next;
+    }
+}
+
+void* Arena::allocate(size_t size) {
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    size = alignSize(size);
+    if ((size_t)(end_ - ptr_) < size) {
+        const size_t n = (size > chunkSize_) ? size : chunkSize_;
+        auto c = (Chunk*)::malloc(sizeof(Chunk) + n);
+        if (!c) {
+            return nullptr;
+        }
+        c->next = chunks_;
+        c->size = n;
+        chunks_ = c;
+        ptr_ = (char*)(c + 1);
+        end_ = ptr_ + n;
+    }
+    auto p = ptr_;
+    ptr_ += size;
+    allocSize_ += size;
+    return p;
+}
+
+bool Arena::resize(void* ptr, size_t oldSize, size_t newSize) {
+    if (!isValidSize(newSize)) {
+        return false;
+    }
+    oldSize = alignSize(oldSize);
+    newSize = alignSize(newSize);
+    if ((char*)ptr + oldSize != ptr_ || newSize > (size_t)(end_ - (char*)ptr)) {
+        return false;
+    }
+    ptr_ = (char*)ptr + newSize;
+    allocSize_ = allocSize_ - oldSize + newSize;
+    return true;
+}
+
+void Arena::reset() {
+    if (!chunks_) {
+        return;
+    }
+    auto c = chunks_->next;
+    while (c) {
+        auto next = c->next;
+        ::free(c);
+        c = next;
+    }
+    chunks_->next = nullptr;
+    ptr_ = (char*)(chunks_ + 1);
+    end_ = ptr_ + chunks_->size;
+    allocSize_ = 0;
+}
+
+Arena* Arena::current() {
+    return s_current;
+}
+
+// spark::ArenaScope
+ArenaScope::ArenaScope(Arena& arena, bool resetOnExit) :
+        arena_(arena),
+        prev_(Arena::s_current),
+        reset_(resetOnExit) {
+    Arena::s_current = &arena;
+}
+
+ArenaScope::~ArenaScope() {
+    Arena::s_current = prev_;
+    if (reset_) {
+        arena_.reset();
+    }
+}
+
+// spark::ArenaAllocator
+void* ArenaAllocator::malloc(size_t size) {
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    const auto arena = Arena::current();
+    BlockHeader* h = nullptr;
+    if (arena) {
+        h = (BlockHeader*)arena->allocate(sizeof(BlockHeader) + size);
+    } else {
+        h = (BlockHeader*)::malloc(sizeof(BlockHeader) + size);
+    }
+    if (!h) {
+        return nullptr;
+    }
+    h->size = size;
+    h->owner = arena;
+    return blockData(h);
+}
+
+void* ArenaAllocator::realloc(void* ptr, size_t size) {
+    if (!ptr) {
+        return malloc(size);
+    }
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    auto h = blockHeader(ptr);
+    if (!h->owner) {
+        h = (BlockHeader*)::realloc(h, sizeof(BlockHeader) + size);
+        if (!h) {
+            return nullptr;
+        }
+        h->size = size;
+        return blockData(h);
+    }
+    if (size <= h->size) {
+        return ptr;
+    }
+    auto arena = (Arena*)h->owner;
+    if (arena->resize(h, sizeof(BlockHeader) + h->size, sizeof(BlockHeader) + size)) {
+        h->size = size;
+        return ptr;
+    }
+    // The block is moved within the arena it was allocated from, which is not necessarily the
+    // current one
+    auto newH = (BlockHeader*)arena->allocate(sizeof(BlockHeader) + size);
+    if (!newH) {
+        return nullptr;
+    }
+    newH->size = size;
+    newH->owner = arena;
+    memcpy(blockData(newH), ptr, h->size);
+    return blockData(newH);
+}
+
+void ArenaAllocator::free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto h = blockHeader(ptr);
+    if (!h->owner) {
+        ::free(h);
+    }
+}
+
+// spark::CachingAllocator
+void* CachingAllocator::malloc(size_t size) {
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    size_t n = sizeof(BlockHeader) + size;
+    BlockHeader* h = nullptr;
+    if (n <= MAX_CACHED_SIZE) {
+        const auto i = cachedSizeClass(n);
+        n = MIN_CACHED_SIZE << i;
+        h = t_cache.blocks[i];
+        if (h) {
+            t_cache.blocks[i] = *(BlockHeader**)blockData(h);
+            --t_cache.count[i];
+        }
+    }
+    if (!h) {
+        h = (BlockHeader*)::malloc(n);
+        if (!h) {
+            return nullptr;
+        }
+    }
+    h->size = n - sizeof(BlockHeader);
+    h->owner = nullptr;
+    return blockData(h);
+}
+
+void* CachingAllocator::realloc(void* ptr, size_t size) {
+    if (!ptr) {
+        return malloc(size);
+    }
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    auto h = blockHeader(ptr);
+    if (size <= h->size) {
+        return ptr;
+    }
+    if (sizeof(BlockHeader) + h->size > MAX_CACHED_SIZE) {
+        // Neither the old nor the new block is cacheable
+        h = (BlockHeader*)::realloc(h, sizeof(BlockHeader) + size);
+        if (!h) {
+            return nullptr;
+        }
+        h->size = size;
+        return blockData(h);
+    }
+    auto p = malloc(size);
+    if (!p) {
+        return nullptr;
+    }
+    memcpy(p, ptr, h->size);
+    free(ptr);
+    return p;
+}
+
+void CachingAllocator::free(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto h = blockHeader(ptr);
+    const size_t n = sizeof(BlockHeader) + h->size;
+    if (n <= MAX_CACHED_SIZE && !t_cache.disabled) {
+        const auto i = cachedSizeClass(n);
+        if (t_cache.count[i] < MAX_CACHED_BLOCKS) {
+            initBlockCacheGuard();
+            *(BlockHeader**)blockData(h) = t_cache.blocks[i];
+            t_cache.blocks[i] = h;
+            ++t_cache.count[i];
+            return;
+        }
+    }
+    ::free(h);
+}
+
+namespace detail {
+
+// spark::detail::BlockPool
+BlockPool::BlockPool(size_t blockSize, size_t blocksPerChunk) :
+        free_(nullptr),
+        blockSize_(blockSize),
+        blocksPerChunk_(blocksPerChunk) {
+}
+
+void* BlockPool::allocate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_) {
+        const size_t n = alignSize(sizeof(BlockHeader) + blockSize_);
+        auto p = (char*)::malloc(n * blocksPerChunk_);
+        if (!p) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < blocksPerChunk_; ++i) {
+            auto b = (FreeBlock*)(p + i * n);
+            b->next = free_;
+            free_ = b;
+        }
+    }
+    auto b = free_;
+    free_ = b->next;
+    return b;
+}
+
+void BlockPool::deallocate(void* ptr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto b = (FreeBlock*)ptr;
+    b->next = free_;
+    free_ = b;
+}
+
+void* poolMalloc(BlockPool& pool, size_t size) {
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    BlockHeader* h = nullptr;
+    if (size <= pool.blockSize()) {
+        h = (BlockHeader*)pool.allocate();
+        if (!h) {
+            return nullptr;
+        }
+        h->size = pool.blockSize();
+        h->owner = &pool;
+    } else {
+        h = (BlockHeader*)::malloc(sizeof(BlockHeader) + size);
+        if (!h) {
+            return nullptr;
+        }
+        h->size = size;
+        h->owner = nullptr;
+    }
+    return blockData(h);
+}
+
+void* poolRealloc(BlockPool& pool, void* ptr, size_t size) {
+    if (!ptr) {
+        return poolMalloc(pool, size);
+    }
+    if (!isValidSize(size)) {
+        return nullptr;
+    }
+    auto h = blockHeader(ptr);
+    if (size <= h->size) {
+        return ptr;
+    }
+    if (!h->owner) {
+        h = (BlockHeader*)::realloc(h, sizeof(BlockHeader) + size);
+        if (!h) {
+            return nullptr;
+        }
+        h->size = size;
+        return blockData(h);
+    }
+    auto p = poolMalloc(pool, size);
+    if (!p) {
+        return nullptr;
+    }
+    memcpy(p, ptr, h->size);
+    poolFree(pool, ptr);
+    return p;
+}
+
+void poolFree(BlockPool& pool, void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto h = blockHeader(ptr);
+    if (h->owner) {
+        pool.deallocate(h);
+    } else {
+        ::free(h);
+    }
+}
+
+} // namespace detail
+
+} // namespace spark
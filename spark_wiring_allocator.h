@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <cstddef>
+
+namespace spark {
+
+/**
+ * A monotonic memory arena.
+ *
+ * The arena allocates memory in large chunks and hands it out by advancing a pointer. Individual
+ * allocations cannot be freed; instead, all memory allocated from the arena is released at once
+ * by calling `reset()` or destroying the arena.
+ *
+ * An arena is not used directly by containers. Instead, it is made current for the calling thread
+ * using `ArenaScope`, and containers parameterized with `ArenaAllocator` allocate their memory
+ * from the current arena.
+ */
+class Arena {
+public:
+    /**
+     * Default size of a memory chunk.
+     */
+    static const size_t DEFAULT_CHUNK_SIZE = 4096;
+
+    /**
+     * Constructor.
+     *
+     * @param chunkSize Size of a memory chunk. Allocations larger than the chunk size get a
+     *        dedicated chunk.
+     */
+    explicit Arena(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * Destructor.
+     *
+     * Releases all memory allocated from the arena.
+     */
+    ~Arena();
+
+    /**
+     * Allocate a block of memory.
+     *
+     * The returned memory is suitably aligned for any fundamental type.
+     *
+     * @param size Block size.
+     * @return Pointer to the allocated block, or `nullptr` on a memory allocation error.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * Resize a block of memory in place.
+     *
+     * Only the most recently allocated block can be resized.
+     *
+     * @param ptr Pointer to the block.
+     * @param oldSize Current block size.
+     * @param newSize New block size.
+     * @return `true` if the block was resized, otherwise `false`.
+     */
+    bool resize(void* ptr, size_t oldSize, size_t newSize);
+
+    /**
+     * Release all memory allocated from the arena.
+     *
+     * The most recently allocated chunk is kept for reuse.
+     */
+    void reset();
+
+    /**
+     * Get the total number of bytes allocated from the arena since it was last reset.
+     *
+     * @return Number of bytes.
+     */
+    size_t allocatedSize() const {
+        return allocSize_;
+    }
+
+    /**
+     * Get the arena that is current for the calling thread.
+     *
+     * @return Current arena, or `nullptr` if there is no current arena.
+     */
+    static Arena* current();
+
+    // This class is non-copyable
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+private:
+    struct Chunk;
+
+    Chunk* chunks_;
+    char* ptr_;
+    char* end_;
+    size_t chunkSize_;
+    size_t allocSize_;
+
+    static thread_local Arena* s_current;
+
+    friend class ArenaScope;
+};
+
+/**
+ * Makes an arena current for the calling thread for the lifetime of the scope object.
+ *
+ * When the scope object is destroyed, the previously current arena is restored and, unless
+ * disabled, the arena is reset. All containers that allocated memory from the arena must be
+ * destroyed before that happens:
+ *
+ * ```
+ * Arena arena;
+ * {
+ *     ArenaScope scope(arena);
+ *     Variant v; // Declared after the scope object so that it's destroyed first
+ *     decodeFromCBOR(v, stream);
+ *     ...
+ * } // Releases all memory used by v at once
+ * ```
+ */
+class ArenaScope {
+public:
+    /**
+     * Constructor.
+     *
+     * @param arena Arena.
+     * @param resetOnExit Whether to reset the arena when the scope object is destroyed.
+     */
+    explicit ArenaScope(Arena& arena, bool resetOnExit = true);
+
+    /**
+     * Destructor.
+     */
+    ~ArenaScope();
+
+    // This class is non-copyable
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    Arena& arena_;
+    Arena* prev_;
+    bool reset_;
+};
+
+/**
+ * Allocator that allocates memory from the current arena.
+ *
+ * If there's no current arena, memory is allocated on the heap. Freeing a block allocated from
+ * an arena is a no-op; the memory is reclaimed when the arena is reset. A block that was allocated
+ * from an arena can still be reallocated or freed after the arena is no longer current, as long
+ * as the arena hasn't been reset.
+ */
+struct ArenaAllocator {
+    static void* malloc(size_t size);
+    static void* realloc(void* ptr, size_t size);
+    static void free(void* ptr);
+};
+
+/**
+ * Allocator that caches freed blocks in per-thread lists.
+ *
+ * Block sizes are rounded up to a power of two. Freed blocks of up to `MAX_CACHED_SIZE` bytes are
+ * kept in a list of blocks of the same size owned by the calling thread and reused by subsequent
+ * allocations in that thread. The cached blocks are released when the thread exits. A block can be
+ * freed by a thread other than the one that allocated it.
+ */
+struct CachingAllocator {
+    static const size_t MAX_CACHED_SIZE = 4096;
+    static const unsigned MAX_CACHED_BLOCKS = 32;
+
+    static void* malloc(size_t size);
+    static void* realloc(void* ptr, size_t size);
+    static void free(void* ptr);
+};
+
+namespace detail {
+
+// Header of a block allocated by one of the allocators defined in this file
+struct alignas(std::max_align_t) BlockHeader {
+    size_t size; // Usable size of the block
+    void* owner; // Arena or pool the block was allocated from, or null if it's a heap block
+};
+
+// A thread-safe pool of fixed-size blocks. The memory chunks allocated by the pool are never
+// released so that containers with static storage duration can safely free their blocks at exit
+class BlockPool {
+public:
+    BlockPool(size_t blockSize, size_t blocksPerChunk);
+
+    void* allocate();
+    void deallocate(void* ptr);
+
+    size_t blockSize() const {
+        return blockSize_;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::mutex mutex_;
+    FreeBlock* free_;
+    size_t blockSize_;
+    size_t blocksPerChunk_;
+};
+
+void* poolMalloc(BlockPool& pool, size_t size);
+void* poolRealloc(BlockPool& pool, void* ptr, size_t size);
+void poolFree(BlockPool& pool, void* ptr);
+
+} // namespace detail
+
+/**
+ * Allocator that allocates same-sized blocks from a pool.
+ *
+ * Allocations of up to `BlockSize` bytes are served from a free list shared by all containers
+ * parameterized with the same allocator type; larger allocations fall back to the heap. The pool
+ * grows by `BlocksPerChunk` blocks at a time and never shrinks.
+ *
+ * @tparam BlockSize Block size.
+ * @tparam BlocksPerChunk Number of blocks allocated at once when the pool is empty.
+ */
+template<size_t BlockSize, size_t BlocksPerChunk = 32>
+struct PoolAllocator {
+    static_assert(BlockSize > 0 && BlocksPerChunk > 0, "Invalid pool parameters");
+
+    static void* malloc(size_t size) {
+        return detail::poolMalloc(pool(), size);
+    }
+
+    static void* realloc(void* ptr, size_t size) {
+        return detail::poolRealloc(pool(), ptr, size);
+    }
+
+    static void free(void* ptr) {
+        detail::poolFree(pool(), ptr);
+    }
+
+private:
+    static detail::BlockPool& pool() {
+        static detail::BlockPool p(BlockSize, BlocksPerChunk);
+        return p;
+    }
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::Arena;
+using ::spark::ArenaScope;
+using ::spark::ArenaAllocator;
+using ::spark::CachingAllocator;
+using ::spark::PoolAllocator;
+
+} // namespace particle
@@ -0,0 +1,967 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <new>
+#include <cstring>
+
+#include "spark_wiring_vector.h"
+
+#include "debug.h"
+
+namespace particle {
+
+/**
+ * An ordered associative container with unique keys.
+ *
+ * Internally, `BTreeMap` is a B+ tree: the entries are stored in leaf nodes that are linked into a
+ * list in key order, and the inner nodes store copies of the keys that separate their subtrees.
+ * Unlike `Map`, inserting or removing an entry only moves the entries of a single node, so the map
+ * stays efficient with hundreds of thousands of entries.
+ *
+ * Inserting or removing an entry invalidates all iterators.
+ *
+ * @tparam KeyT Key type.
+ * @tparam ValueT Value type.
+ * @tparam CompareT Comparator type.
+ * @tparam AllocatorT Allocator type used for the nodes of the tree.
+ */
+template<typename KeyT, typename ValueT, typename CompareT = std::less<KeyT>, typename AllocatorT = spark::DefaultAllocator>
+class BTreeMap {
+public:
+    /**
+     * Key type.
+     */
+    typedef KeyT Key;
+
+    /**
+     * Value type.
+     */
+    typedef ValueT Value;
+
+    /**
+     * Comparator type.
+     */
+    typedef CompareT Compare;
+
+    /**
+     * Entry type.
+     */
+    typedef std::pair<const KeyT, ValueT> Entry;
+
+    /**
+     * Maximum number of entries stored in a leaf node.
+     */
+    static const int LEAF_CAPACITY = (512 / sizeof(Entry) > 4) ? 512 / sizeof(Entry) : 4;
+
+    /**
+     * Maximum number of keys stored in an inner node.
+     */
+    static const int INNER_CAPACITY = (512 / (sizeof(KeyT) + sizeof(void*)) > 4) ? 512 / (sizeof(KeyT) + sizeof(void*)) : 4;
+
+private:
+    struct Leaf;
+
+    template<bool ConstT>
+    class IteratorBase {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef Entry value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef std::conditional_t<ConstT, const Entry*, Entry*> pointer;
+        typedef std::conditional_t<ConstT, const Entry&, Entry&> reference;
+
+        IteratorBase() :
+                leaf_(nullptr),
+                index_(0) {
+        }
+
+        template<bool C = ConstT, typename = std::enable_if_t<C>>
+        IteratorBase(const IteratorBase<false>& it) :
+                leaf_(it.leaf_),
+                index_(it.index_) {
+        }
+
+        reference operator*() const {
+            return leaf_->entries()[index_];
+        }
+
+        pointer operator->() const {
+            return &leaf_->entries()[index_];
+        }
+
+        IteratorBase& operator++() {
+            if (++index_ == leaf_->count && leaf_->next) {
+                leaf_ = leaf_->next;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        IteratorBase operator++(int) {
+            auto it = *this;
+            ++(*this);
+            return it;
+        }
+
+        IteratorBase& operator--() {
+            if (index_ == 0) {
+                leaf_ = leaf_->prev;
+                index_ = leaf_->count;
+            }
+            --index_;
+            return *this;
+        }
+
+        IteratorBase operator--(int) {
+            auto it = *this;
+            --(*this);
+            return it;
+        }
+
+        bool operator==(const IteratorBase& it) const {
+            return leaf_ == it.leaf_ && index_ == it.index_;
+        }
+
+        bool operator!=(const IteratorBase& it) const {
+            return !operator==(it);
+        }
+
+    private:
+        Leaf* leaf_;
+        int index_;
+
+        IteratorBase(Leaf* leaf, int index) :
+                leaf_(leaf),
+                index_(index) {
+        }
+
+        friend class BTreeMap;
+        friend class IteratorBase<true>;
+    };
+
+public:
+    /**
+     * Iterator type.
+     */
+    typedef IteratorBase<false> Iterator;
+
+    /**
+     * Constant interator type.
+     */
+    typedef IteratorBase<true> ConstIterator;
+
+    /**
+     * Construct an empty map.
+     */
+    BTreeMap() :
+            root_(nullptr),
+            head_(nullptr),
+            tail_(nullptr),
+            size_(0),
+            height_(0) {
+    }
+
+    /**
+     * Construct a map from an initializer list.
+     *
+     * @param entries Entries.
+     */
+    BTreeMap(std::initializer_list<Entry> entries) :
+            BTreeMap() {
+        BTreeMap map;
+        for (auto& e: entries) {
+            if (!map.set(e.first, e.second)) {
+                return;
+            }
+        }
+        swap(*this, map);
+    }
+
+    /**
+     * Copy constructor.
+     *
+     * @param map Map to copy.
+     */
+    BTreeMap(const BTreeMap& map) :
+            BTreeMap() {
+        BTreeMap m;
+        m.cmp_ = map.cmp_;
+        for (auto& e: map) {
+            if (!m.set(e.first, e.second)) {
+                return;
+            }
+        }
+        swap(*this, m);
+    }
+
+    /**
+     * Move constructor.
+     *
+     * @param map Map to move from.
+     */
+    BTreeMap(BTreeMap&& map) :
+            BTreeMap() {
+        swap(*this, map);
+    }
+
+    /**
+     * Destructor.
+     */
+    ~BTreeMap() {
+        clear();
+    }
+
+    ///@{
+    /**
+     * Add or update an entry.
+     *
+     * @param key Key.
+     * @param val Value.
+     * @return `true` if the entry was added or updated, or `false` on a memory allocation error.
+     */
+    template<typename T>
+    bool set(const T& key, ValueT val) {
+        auto r = insert(key, std::move(val));
+        if (r.first == end()) {
+            return false;
+        }
+        return true;
+    }
+
+    bool set(KeyT&& key, ValueT val) {
+        auto r = insert(std::move(key), std::move(val));
+        if (r.first == end()) {
+            return false;
+        }
+        return true;
+    }
+    ///@}
+
+    /**
+     * Get the value of an entry.
+     *
+     * A default-constructed value is returned if an entry with the given key cannot be found.
+     *
+     * @param key Key.
+     * @return Value.
+     */
+    template<typename T>
+    ValueT get(const T& key) const {
+        auto it = find(key);
+        if (it == end()) {
+            return ValueT();
+        }
+        return it->second;
+    }
+
+    /**
+     * Get the value of an entry.
+     *
+     * @param key Key.
+     * @param defaultVal Value to return if an entry with the given key cannot be found.
+     * @return Value.
+     */
+    template<typename T>
+    ValueT get(const T& key, const ValueT& defaultVal) const {
+        auto it = find(key);
+        if (it == end()) {
+            return defaultVal;
+        }
+        return it->second;
+    }
+
+    /**
+     * Remove an entry.
+     *
+     * @param key Key.
+     * @return `true` if the entry was removed, otherwise `false`.
+     */
+    template<typename T>
+    bool remove(const T& key) {
+        Path path;
+        auto leaf = findLeaf(key, path);
+        if (!leaf) {
+            return false;
+        }
+        const int i = leafLowerBound(leaf, key);
+        if (i == leaf->count || cmp_(key, leaf->entries()[i].first)) {
+            return false;
+        }
+        eraseAt(path, leaf, i);
+        return true;
+    }
+
+    /**
+     * Check if the map contains an entry.
+     *
+     * @param key Key.
+     * @return `true` if an entry with the given key is found, otherwise `false`.
+     */
+    template<typename T>
+    bool has(const T& key) const {
+        return find(key) != end();
+    }
+
+    /**
+     * Get the number of entries in the map.
+     *
+     * @return Number of entries.
+     */
+    int size() const {
+        return size_;
+    }
+
+    /**
+     * Check if the map is empty.
+     *
+     * @return `true` if the map is empty, otherwise `false`.
+     */
+    bool isEmpty() const {
+        return !size_;
+    }
+
+    /**
+     * Remove all entries.
+     */
+    void clear() {
+        if (root_) {
+            freeNode(root_, height_);
+        }
+        root_ = nullptr;
+        head_ = nullptr;
+        tail_ = nullptr;
+        size_ = 0;
+        height_ = 0;
+    }
+
+    ///@{
+    /**
+     * Get an iterator pointing to the first entry of the map.
+     *
+     * @return Iterator.
+     */
+    Iterator begin() {
+        return Iterator(head_, 0);
+    }
+
+    ConstIterator begin() const {
+        return ConstIterator(head_, 0);
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Get an iterator pointing to the entry following the last entry of the map.
+     *
+     * @return Iterator.
+     */
+    Iterator end() {
+        return Iterator(tail_, tail_ ? tail_->count : 0);
+    }
+
+    ConstIterator end() const {
+        return ConstIterator(tail_, tail_ ? tail_->count : 0);
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Find an entry.
+     *
+     * If an entry with the given key cannot be found, an iterator pointing to the entry following
+     * the last entry of the map is returned.
+     *
+     * @param key Key.
+     * @return Iterator pointing to the entry.
+     */
+    template<typename T>
+    Iterator find(const T& key) {
+        auto it = lowerBound(key);
+        if (it != end() && cmp_(key, it->first)) {
+            return end();
+        }
+        return it;
+    }
+
+    template<typename T>
+    ConstIterator find(const T& key) const {
+        auto it = lowerBound(key);
+        if (it != end() && cmp_(key, it->first)) {
+            return end();
+        }
+        return it;
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Add or update an entry.
+     *
+     * On a memory allocation error, an iterator pointing to the entry following the last entry of
+     * the map is returned.
+     *
+     * @param key Key.
+     * @param val Value.
+     * @return `std::pair` where `first` is an iterator pointing to the entry, and `second` is set
+     *         to `true` if the entry was inserted, or `false` if it was updated.
+     */
+    template<typename T>
+    std::pair<Iterator, bool> insert(const T& key, ValueT val) {
+        return insertImpl(key, std::move(val));
+    }
+
+    std::pair<Iterator, bool> insert(KeyT&& key, ValueT val) {
+        return insertImpl(std::move(key), std::move(val));
+    }
+    ///@}
+
+    /**
+     * Remove an entry.
+     *
+     * @param pos Iterator pointing to the entry to be removed.
+     * @return Iterator pointing to the entry following the removed entry.
+     */
+    Iterator erase(ConstIterator pos) {
+        Path path;
+        auto leaf = findLeaf(pos->first, path);
+        SPARK_ASSERT(leaf == pos.leaf_);
+        return eraseAt(path, leaf, pos.index_);
+    }
+
+    ///@{
+    /**
+     * Get an iterator pointing to first entry of the map whose key compares not less than the
+     * provided key.
+     *
+     * @param key Key.
+     * @return Iterator.
+     */
+    template<typename T>
+    Iterator lowerBound(const T& key) {
+        auto it = static_cast<const BTreeMap*>(this)->lowerBound(key);
+        return Iterator(it.leaf_, it.index_);
+    }
+
+    template<typename T>
+    ConstIterator lowerBound(const T& key) const {
+        Path path;
+        auto leaf = findLeaf(key, path);
+        if (!leaf) {
+            return end();
+        }
+        return position(leaf, leafLowerBound(leaf, key));
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Get an iterator pointing to first entry of the map whose key compares greater than the
+     * provided key.
+     *
+     * @param key Key.
+     * @return Iterator.
+     */
+    template<typename T>
+    Iterator upperBound(const T& key) {
+        auto it = static_cast<const BTreeMap*>(this)->upperBound(key);
+        return Iterator(it.leaf_, it.index_);
+    }
+
+    template<typename T>
+    ConstIterator upperBound(const T& key) const {
+        Path path;
+        auto leaf = findLeaf(key, path);
+        if (!leaf) {
+            return end();
+        }
+        auto e = leaf->entries();
+        const int i = std::upper_bound(e, e + leaf->count, key, [this](const T& key, const Entry& entry) {
+            return this->cmp_(key, entry.first);
+        }) - e;
+        return position(leaf, i);
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Get a reference to the value of an entry.
+     *
+     * The entry is created if it doesn't exist.
+     *
+     * @note The device will panic if it fails to allocate memory for the new entry. Use `set()` or
+     * `insert()` if you need more control over how memory allocation errors are handled.
+     *
+     * @param key Key.
+     * @return Value.
+     */
+    template<typename T>
+    ValueT& operator[](const T& key) {
+        auto it = find(key);
+        if (it == end()) {
+            it = insert(key, ValueT()).first;
+            SPARK_ASSERT(it != end());
+        }
+        return it->second;
+    }
+
+    ValueT& operator[](KeyT&& key) {
+        auto it = find(key);
+        if (it == end()) {
+            it = insert(std::move(key), ValueT()).first;
+            SPARK_ASSERT(it != end());
+        }
+        return it->second;
+    }
+    ///@}
+
+    /**
+     * Assignment operator.
+     *
+     * @param map Map to assign from.
+     * @return This map.
+     */
+    BTreeMap& operator=(BTreeMap map) {
+        swap(*this, map);
+        return *this;
+    }
+
+    /**
+     * Comparison operators.
+     *
+     * Two maps are equal if they contain equal sets of entries.
+     */
+    ///@{
+    bool operator==(const BTreeMap& map) const {
+        if (size_ != map.size_) {
+            return false;
+        }
+        return std::equal(begin(), end(), map.begin());
+    }
+
+    bool operator!=(const BTreeMap& map) const {
+        return !operator==(map);
+    }
+    ///@}
+
+    friend void swap(BTreeMap& map1, BTreeMap& map2) {
+        using std::swap; // For ADL
+        swap(map1.root_, map2.root_);
+        swap(map1.head_, map2.head_);
+        swap(map1.tail_, map2.tail_);
+        swap(map1.size_, map2.size_);
+        swap(map1.height_, map2.height_);
+        swap(map1.cmp_, map2.cmp_);
+    }
+
+private:
+    // Maximum height of the tree. Each inner node has at least 2 children
+    static const int MAX_HEIGHT = 32;
+
+    static const int LEAF_MIN = LEAF_CAPACITY / 2;
+    static const int INNER_MIN = INNER_CAPACITY / 2;
+
+    struct Node {
+        int count; // Number of entries in a leaf node, or number of keys in an inner node
+    };
+
+    // Leaf and inner nodes have room for one extra element so that a node can be split after
+    // an element is inserted into it
+    struct Leaf: Node {
+        Leaf* prev;
+        Leaf* next;
+        alignas(Entry) char data[(LEAF_CAPACITY + 1) * sizeof(Entry)];
+
+        Entry* entries() {
+            return (Entry*)data;
+        }
+    };
+
+    struct Inner: Node {
+        Node* children[INNER_CAPACITY + 2];
+        alignas(KeyT) char data[(INNER_CAPACITY + 1) * sizeof(KeyT)];
+
+        KeyT* keys() {
+            return (KeyT*)data;
+        }
+    };
+
+    struct PathElement {
+        Inner* node;
+        int index; // Index of the child
+    };
+
+    typedef PathElement Path[MAX_HEIGHT];
+
+    Node* root_;
+    Leaf* head_;
+    Leaf* tail_;
+    int size_;
+    int height_; // Number of inner levels
+    CompareT cmp_;
+
+    // Move elements between possibly overlapping ranges of node storage
+    template<typename T>
+    static void relocate(T* dest, T* src, int n) {
+        if (dest == src || n <= 0) {
+            return;
+        }
+        if (spark::IsTriviallyRelocatable<T>::value) {
+            memmove((void*)dest, (const void*)src, n * sizeof(T));
+        } else if (dest < src) {
+            for (int i = 0; i < n; ++i) {
+                new(dest + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        } else {
+            for (int i = n - 1; i >= 0; --i) {
+                new(dest + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    template<typename T>
+    Leaf* findLeaf(const T& key, Path& path) const {
+        Node* n = root_;
+        for (int level = 0; level < height_; ++level) {
+            auto inner = static_cast<Inner*>(n);
+            auto k = inner->keys();
+            const int i = std::upper_bound(k, k + inner->count, key, [this](const T& key, const KeyT& k) {
+                return this->cmp_(key, k);
+            }) - k;
+            path[level] = { inner, i };
+            n = inner->children[i];
+        }
+        return static_cast<Leaf*>(n);
+    }
+
+    template<typename T>
+    int leafLowerBound(Leaf* leaf, const T& key) const {
+        auto e = leaf->entries();
+        return std::lower_bound(e, e + leaf->count, key, [this](const Entry& entry, const T& key) {
+            return this->cmp_(entry.first, key);
+        }) - e;
+    }
+
+    ConstIterator position(Leaf* leaf, int index) const {
+        if (index == leaf->count && leaf->next) {
+            return ConstIterator(leaf->next, 0);
+        }
+        return ConstIterator(leaf, index);
+    }
+
+    template<typename NodeT>
+    static NodeT* allocNode() {
+        auto p = AllocatorT::malloc(sizeof(NodeT));
+        if (!p) {
+            return nullptr;
+        }
+        auto n = new(p) NodeT;
+        n->count = 0;
+        return n;
+    }
+
+    static void deallocNode(Node* node) {
+        AllocatorT::free(node);
+    }
+
+    void freeNode(Node* node, int height) {
+        if (height > 0) {
+            auto inner = static_cast<Inner*>(node);
+            for (int i = 0; i <= inner->count; ++i) {
+                freeNode(inner->children[i], height - 1);
+            }
+            for (int i = 0; i < inner->count; ++i) {
+                inner->keys()[i].~KeyT();
+            }
+        } else {
+            auto leaf = static_cast<Leaf*>(node);
+            for (int i = 0; i < leaf->count; ++i) {
+                leaf->entries()[i].~Entry();
+            }
+        }
+        deallocNode(node);
+    }
+
+    template<typename K>
+    std::pair<Iterator, bool> insertImpl(K&& key, ValueT&& val) {
+        if (!root_) {
+            auto leaf = allocNode<Leaf>();
+            if (!leaf) {
+                return std::make_pair(end(), false);
+            }
+            leaf->prev = nullptr;
+            leaf->next = nullptr;
+            root_ = leaf;
+            head_ = leaf;
+            tail_ = leaf;
+        }
+        Path path;
+        auto leaf = findLeaf(key, path);
+        int i = leafLowerBound(leaf, key);
+        if (i < leaf->count && !cmp_(key, leaf->entries()[i].first)) {
+            leaf->entries()[i].second = std::move(val);
+            return std::make_pair(Iterator(leaf, i), false);
+        }
+        // Allocate all nodes needed to split the leaf and its ancestors beforehand so that the tree
+        // remains consistent on a memory allocation error
+        Leaf* newLeaf = nullptr;
+        Inner* newInner[MAX_HEIGHT + 1] = {};
+        int innerCount = 0;
+        if (leaf->count == LEAF_CAPACITY) {
+            newLeaf = allocNode<Leaf>();
+            if (!newLeaf) {
+                return std::make_pair(end(), false);
+            }
+            int level = height_ - 1;
+            while (level >= 0 && path[level].node->count == INNER_CAPACITY) {
+                ++innerCount;
+                --level;
+            }
+            if (level < 0) {
+                ++innerCount; // New root
+            }
+            for (int j = 0; j < innerCount; ++j) {
+                newInner[j] = allocNode<Inner>();
+                if (!newInner[j]) {
+                    for (int k = 0; k <= j; ++k) {
+                        deallocNode(newInner[k]);
+                    }
+                    deallocNode(newLeaf);
+                    return std::make_pair(end(), false);
+                }
+            }
+        }
+        auto e = leaf->entries();
+        relocate(e + i + 1, e + i, leaf->count - i);
+        new(e + i) Entry(KeyT(std::forward<K>(key)), std::move(val));
+        ++leaf->count;
+        ++size_;
+        if (!newLeaf) {
+            return std::make_pair(Iterator(leaf, i), true);
+        }
+        // Split the leaf. When appending to the last leaf, keep it full so that entries inserted in
+        // ascending order fill the leaves completely
+        const int n = leaf->count;
+        const int m = (i == n - 1 && !leaf->next) ? LEAF_CAPACITY : n / 2;
+        relocate(newLeaf->entries(), e + m, n - m);
+        newLeaf->count = n - m;
+        leaf->count = m;
+        newLeaf->prev = leaf;
+        newLeaf->next = leaf->next;
+        if (leaf->next) {
+            leaf->next->prev = newLeaf;
+        } else {
+            tail_ = newLeaf;
+        }
+        leaf->next = newLeaf;
+        Iterator it = (i < m) ? Iterator(leaf, i) : Iterator(newLeaf, i - m);
+        // Insert the separator key into the ancestors, splitting them as necessary
+        KeyT sep(newLeaf->entries()[0].first);
+        Node* right = newLeaf;
+        Inner** spare = newInner;
+        for (int level = height_ - 1;; --level) {
+            if (level < 0) {
+                auto r = *spare;
+                new(r->keys()) KeyT(std::move(sep));
+                r->children[0] = root_;
+                r->children[1] = right;
+                r->count = 1;
+                root_ = r;
+                ++height_;
+                break;
+            }
+            auto node = path[level].node;
+            const int ci = path[level].index;
+            auto k = node->keys();
+            relocate(k + ci + 1, k + ci, node->count - ci);
+            new(k + ci) KeyT(std::move(sep));
+            memmove(node->children + ci + 2, node->children + ci + 1, (node->count - ci) * sizeof(Node*));
+            node->children[ci + 1] = right;
+            ++node->count;
+            if (node->count <= INNER_CAPACITY) {
+                break;
+            }
+            // Split the inner node and promote its middle key
+            auto r = *spare++;
+            const int cnt = node->count;
+            const int mid = cnt / 2;
+            sep = std::move(k[mid]);
+            k[mid].~KeyT();
+            relocate(r->keys(), k + mid + 1, cnt - mid - 1);
+            memcpy(r->children, node->children + mid + 1, (cnt - mid) * sizeof(Node*));
+            r->count = cnt - mid - 1;
+            node->count = mid;
+            right = r;
+        }
+        return std::make_pair(it, true);
+    }
+
+    // Remove the child with the given index and the key preceding it
+    static void removeChild(Inner* node, int index) {
+        auto k = node->keys();
+        k[index - 1].~KeyT();
+        relocate(k + index - 1, k + index, node->count - index);
+        memmove(node->children + index, node->children + index + 1, (node->count - index) * sizeof(Node*));
+        --node->count;
+    }
+
+    void unlinkLeaf(Leaf* leaf) {
+        if (leaf->prev) {
+            leaf->prev->next = leaf->next;
+        } else {
+            head_ = leaf->next;
+        }
+        if (leaf->next) {
+            leaf->next->prev = leaf->prev;
+        } else {
+            tail_ = leaf->prev;
+        }
+    }
+
+    Iterator eraseAt(Path& path, Leaf* leaf, int i) {
+        auto e = leaf->entries();
+        e[i].~Entry();
+        relocate(e + i, e + i + 1, leaf->count - i - 1);
+        --leaf->count;
+        --size_;
+        if (height_ == 0) {
+            if (!leaf->count) {
+                clear();
+                return end();
+            }
+            auto it = position(leaf, i);
+            return Iterator(it.leaf_, it.index_);
+        }
+        if (leaf->count >= LEAF_MIN) {
+            auto it = position(leaf, i);
+            return Iterator(it.leaf_, it.index_);
+        }
+        auto parent = path[height_ - 1].node;
+        const int ci = path[height_ - 1].index;
+        auto left = (ci > 0) ? static_cast<Leaf*>(parent->children[ci - 1]) : nullptr;
+        auto right = (ci < parent->count) ? static_cast<Leaf*>(parent->children[ci + 1]) : nullptr;
+        Leaf* pos = leaf;
+        if (left && left->count > LEAF_MIN) {
+            relocate(e + 1, e, leaf->count);
+            relocate(e, left->entries() + left->count - 1, 1);
+            --left->count;
+            ++leaf->count;
+            parent->keys()[ci - 1] = e[0].first;
+            ++i;
+        } else if (right && right->count > LEAF_MIN) {
+            auto re = right->entries();
+            relocate(e + leaf->count, re, 1);
+            relocate(re, re + 1, right->count - 1);
+            --right->count;
+            ++leaf->count;
+            parent->keys()[ci] = re[0].first;
+        } else if (left) {
+            relocate(left->entries() + left->count, e, leaf->count);
+            i += left->count;
+            left->count += leaf->count;
+            unlinkLeaf(leaf);
+            deallocNode(leaf);
+            removeChild(parent, ci);
+            pos = left;
+        } else {
+            relocate(e + leaf->count, right->entries(), right->count);
+            leaf->count += right->count;
+            unlinkLeaf(right);
+            deallocNode(right);
+            removeChild(parent, ci + 1);
+        }
+        rebalanceInner(path, height_ - 1);
+        auto it = position(pos, i);
+        return Iterator(it.leaf_, it.index_);
+    }
+
+    void rebalanceInner(Path& path, int level) {
+        for (; level >= 0; --level) {
+            auto node = path[level].node;
+            if (level == 0) {
+                if (!node->count) {
+                    root_ = node->children[0];
+                    deallocNode(node);
+                    --height_;
+                }
+                return;
+            }
+            if (node->count >= INNER_MIN) {
+                return;
+            }
+            auto parent = path[level - 1].node;
+            const int ci = path[level - 1].index;
+            auto pk = parent->keys();
+            auto k = node->keys();
+            auto left = (ci > 0) ? static_cast<Inner*>(parent->children[ci - 1]) : nullptr;
+            auto right = (ci < parent->count) ? static_cast<Inner*>(parent->children[ci + 1]) : nullptr;
+            if (left && left->count > INNER_MIN) {
+                relocate(k + 1, k, node->count);
+                memmove(node->children + 1, node->children, (node->count + 1) * sizeof(Node*));
+                new(k) KeyT(std::move(pk[ci - 1]));
+                node->children[0] = left->children[left->count];
+                pk[ci - 1] = std::move(left->keys()[left->count - 1]);
+                left->keys()[left->count - 1].~KeyT();
+                --left->count;
+                ++node->count;
+                return;
+            }
+            if (right && right->count > INNER_MIN) {
+                auto rk = right->keys();
+                new(k + node->count) KeyT(std::move(pk[ci]));
+                node->children[node->count + 1] = right->children[0];
+                pk[ci] = std::move(rk[0]);
+                rk[0].~KeyT();
+                relocate(rk, rk + 1, right->count - 1);
+                memmove(right->children, right->children + 1, right->count * sizeof(Node*));
+                --right->count;
+                ++node->count;
+                return;
+            }
+            if (left) {
+                mergeInner(left, pk[ci - 1], node);
+                removeChild(parent, ci);
+            } else {
+                mergeInner(node, pk[ci], right);
+                removeChild(parent, ci + 1);
+            }
+        }
+    }
+
+    // Move the separator key and all keys and children of the right node to the left node
+    static void mergeInner(Inner* left, KeyT& sep, Inner* right) {
+        auto lk = left->keys();
+        new(lk + left->count) KeyT(std::move(sep));
+        relocate(lk + left->count + 1, right->keys(), right->count);
+        memcpy(left->children + left->count + 1, right->children, (right->count + 1) * sizeof(Node*));
+        left->count += right->count + 1;
+        deallocNode(right);
+    }
+};
+
+} // namespace particle
+
+template<typename KeyT, typename ValueT, typename CompareT, typename AllocatorT>
+struct spark::IsTriviallyRelocatable<particle::BTreeMap<KeyT, ValueT, CompareT, AllocatorT>>: spark::IsTriviallyRelocatable<CompareT> {
+};
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_fd_stream.h"
+#include "spark_wiring_error.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+extern uint32_t millis();
+
+namespace spark {
+
+using particle::Error;
+
+namespace {
+
+// Waits until the file descriptor is ready for the requested operation. Returns false on a
+// timeout or error
+bool pollFd(int fd, short events, system_tick_t timeout) {
+    struct pollfd p = {};
+    p.fd = fd;
+    p.events = events;
+    const int t = (timeout > (system_tick_t)INT_MAX) ? INT_MAX : (int)timeout;
+    for (;;) {
+        const int r = ::poll(&p, 1, t);
+        if (r >= 0) {
+            return r > 0;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+}
+
+} // namespace
+
+FdStream::FdStream(int fd, bool ownFd) :
+        bufPos_(0),
+        bufSize_(0),
+        fd_(fd),
+        fdFlags_(::fcntl(fd, F_GETFL)),
+        ownFd_(ownFd),
+        isSocket_(false),
+        end_(false) {
+    if (fdFlags_ >= 0 && !(fdFlags_ & O_NONBLOCK)) {
+        ::fcntl(fd_, F_SETFL, fdFlags_ | O_NONBLOCK);
+    }
+    struct stat st = {};
+    if (::fstat(fd_, &st) == 0) {
+        isSocket_ = S_ISSOCK(st.st_mode);
+    }
+}
+
+FdStream::~FdStream() {
+    if (ownFd_) {
+        ::close(fd_);
+    } else if (fdFlags_ >= 0) {
+        ::fcntl(fd_, F_SETFL, fdFlags_);
+    }
+}
+
+int FdStream::available() {
+    int n = bufSize_ - bufPos_;
+    int k = 0;
+    if (::ioctl(fd_, FIONREAD, &k) == 0 && k > 0) {
+        n += k;
+    }
+    return n;
+}
+
+int FdStream::read() {
+    if (bufPos_ == bufSize_ && !fillBuffer()) {
+        return -1;
+    }
+    return buf_[bufPos_++];
+}
+
+int FdStream::peek() {
+    if (bufPos_ == bufSize_ && !fillBuffer()) {
+        return -1;
+    }
+    return buf_[bufPos_];
+}
+
+void FdStream::flush() {
+    // Written data is not buffered by the stream
+}
+
+size_t FdStream::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t FdStream::write(const uint8_t* data, size_t size) {
+    const system_tick_t start = millis();
+    size_t n = 0;
+    while (n < size) {
+        // Writing to a disconnected socket shouldn't raise SIGPIPE
+        const ssize_t r = isSocket_ ? ::send(fd_, data + n, size - n, MSG_NOSIGNAL) : ::write(fd_, data + n, size - n);
+        if (r >= 0) {
+            n += r;
+            continue;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            setWriteError(Error::IO);
+            break;
+        }
+        const system_tick_t elapsed = millis() - start;
+        if (elapsed >= _timeout || !pollFd(fd_, POLLOUT, _timeout - elapsed)) {
+            setWriteError(Error::TIMEOUT);
+            break;
+        }
+    }
+    return n;
+}
+
+size_t FdStream::readAvailable(uint8_t* buffer, size_t length) {
+    size_t n = bufSize_ - bufPos_;
+    if (n > length) {
+        n = length;
+    }
+    if (n > 0) {
+        memcpy(buffer, buf_ + bufPos_, n);
+        bufPos_ += n;
+    }
+    if (n < length) {
+        n += readFd(buffer + n, length - n);
+    }
+    return n;
+}
+
+bool FdStream::waitAvailable(system_tick_t timeout) {
+    if (bufPos_ != bufSize_) {
+        return true;
+    }
+    if (end_) {
+        return false;
+    }
+    // The caller checks if the timeout has expired
+    pollFd(fd_, POLLIN, timeout);
+    return true;
+}
+
+bool FdStream::fillBuffer() {
+    bufPos_ = 0;
+    bufSize_ = readFd(buf_, sizeof(buf_));
+    return bufSize_ > 0;
+}
+
+size_t FdStream::readFd(uint8_t* data, size_t size) {
+    for (;;) {
+        const ssize_t r = ::read(fd_, data, size);
+        if (r > 0) {
+            end_ = false;
+            return r;
+        }
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return 0;
+            }
+        }
+        end_ = true; // End of stream or an error
+        return 0;
+    }
+}
+
+} // namespace spark
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_FD_STREAM_H
+#define SPARK_WIRING_FD_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "spark_wiring_stream.h"
+
+namespace spark {
+
+/**
+ * A stream backed by a file descriptor.
+ *
+ * The stream can be used with files, pipes, terminals and sockets. The file descriptor is
+ * switched to non-blocking mode, and the stream waits for data with `poll()` instead of polling
+ * the descriptor until the stream timeout expires. Reading at the end of a file, or after the
+ * other end of a pipe or socket has been closed, returns immediately.
+ *
+ * Writes block until all data is written or the stream timeout expires. On an error, the write
+ * error is set to `Error::IO`, or to `Error::TIMEOUT` if the timeout expired. Writing to a pipe
+ * whose read end is closed raises `SIGPIPE` unless the signal is ignored.
+ *
+ * Example usage:
+ * ```
+ * int fds[2];
+ * pipe(fds);
+ * FdStream in(fds[0], true);
+ * FdStream out(fds[1], true);
+ * out.println("123");
+ * int val = in.parseInt();
+ * ```
+ */
+class FdStream: public Stream {
+public:
+    /**
+     * Constructor.
+     *
+     * @param fd File descriptor.
+     * @param ownFd Whether to close the file descriptor when the stream is destroyed.
+     */
+    explicit FdStream(int fd, bool ownFd = false);
+
+    /**
+     * Destructor.
+     *
+     * Restores the original mode of the file descriptor if it's not closed.
+     */
+    ~FdStream();
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+    size_t write(uint8_t b) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    size_t readAvailable(uint8_t* buffer, size_t length) override;
+
+    using Print::write;
+
+    /**
+     * Get the file descriptor.
+     *
+     * @return File descriptor.
+     */
+    int fd() const {
+        return fd_;
+    }
+
+    /**
+     * Check if the end of the stream has been reached.
+     *
+     * @return `true` if the last attempt to read from the file descriptor has reached the end of
+     *         the stream or failed, otherwise `false`.
+     */
+    bool isEnd() const {
+        return end_;
+    }
+
+    // This class is non-copyable
+    FdStream(const FdStream&) = delete;
+    FdStream& operator=(const FdStream&) = delete;
+
+protected:
+    bool waitAvailable(system_tick_t timeout) override;
+
+private:
+    // Single-byte reads are served from a small buffer to avoid a system call per byte
+    static const size_t BUFFER_SIZE = 128;
+
+    uint8_t buf_[BUFFER_SIZE];
+    size_t bufPos_;
+    size_t bufSize_;
+    int fd_;
+    int fdFlags_;
+    bool ownFd_;
+    bool isSocket_;
+    bool end_;
+
+    bool fillBuffer();
+    size_t readFd(uint8_t* data, size_t size);
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::FdStream;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_FD_STREAM_H
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_format.h"
+#include "string_convert.h"
+
+#include <memory>
+#include <new>
+
+namespace spark {
+
+namespace detail {
+
+namespace {
+
+using particle::detail::MAX_INTEGER_STRING_LENGTH;
+using particle::detail::formatDouble;
+using particle::detail::formatUnsigned;
+
+// Floating point numbers that don't fit in this buffer are formatted into a dynamically allocated one
+const size_t DOUBLE_BUFFER_SIZE = 64;
+
+const int DEFAULT_DOUBLE_PRECISION = 6;
+
+inline size_t writeData(Print& out, const char* data, size_t size) {
+    return size ? out.write((const uint8_t*)data, size) : 0;
+}
+
+size_t writeFill(Print& out, char fill, size_t count) {
+    char buf[16];
+    memset(buf, fill, sizeof(buf));
+    size_t n = 0;
+    while (count > 0) {
+        const size_t k = (count < sizeof(buf)) ? count : sizeof(buf);
+        n += out.write((const uint8_t*)buf, k);
+        count -= k;
+    }
+    return n;
+}
+
+// Writes a formatted value with padding. The prefix (sign and base prefix) is kept in front of the
+// zeros if the value is padded with zeros
+size_t writePadded(Print& out, const FormatSpec& spec, const char* prefix, size_t prefixLen, const char* str,
+        size_t len, bool numeric) {
+    const size_t total = prefixLen + len;
+    size_t pad = (spec.width > total) ? spec.width - total : 0;
+    size_t n = 0;
+    if (pad && spec.zeroPad && numeric && !spec.align) {
+        n += writeData(out, prefix, prefixLen);
+        n += writeFill(out, '0', pad);
+        n += writeData(out, str, len);
+        return n;
+    }
+    const char align = spec.align ? spec.align : (numeric ? '>' : '<');
+    size_t left = 0;
+    if (align == '>') {
+        left = pad;
+    } else if (align == '^') {
+        left = pad / 2;
+    }
+    n += writeFill(out, spec.fill, left);
+    n += writeData(out, prefix, prefixLen);
+    n += writeData(out, str, len);
+    n += writeFill(out, spec.fill, pad - left);
+    return n;
+}
+
+size_t writeInteger(Print& out, const FormatSpec& spec, unsigned long long absValue, bool negative) {
+    char prefix[3];
+    size_t prefixLen = 0;
+    if (negative) {
+        prefix[prefixLen++] = '-';
+    } else if (spec.sign) {
+        prefix[prefixLen++] = spec.sign;
+    }
+    unsigned base = 10;
+    switch (spec.type) {
+    case 'x':
+    case 'X':
+        base = 16;
+        break;
+    case 'b':
+        base = 2;
+        break;
+    case 'o':
+        base = 8;
+        break;
+    default:
+        break;
+    }
+    if (spec.alternate && base != 10) {
+        prefix[prefixLen++] = '0';
+        if (base != 8) {
+            prefix[prefixLen++] = (base == 16) ? spec.type : 'b';
+        }
+    }
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    const size_t len = formatUnsigned(absValue, buf, base, spec.type == 'X');
+    return writePadded(out, spec, prefix, prefixLen, buf, len, true /* numeric */);
+}
+
+size_t writeDouble(Print& out, const FormatSpec& spec, double value) {
+    const unsigned precision = (spec.precision >= 0) ? spec.precision : DEFAULT_DOUBLE_PRECISION;
+    char buf[DOUBLE_BUFFER_SIZE];
+    char* str = buf;
+    std::unique_ptr<char[]> bigBuf;
+    size_t len = formatDouble(value, precision, buf, sizeof(buf));
+    if (len >= sizeof(buf)) {
+        bigBuf.reset(new(std::nothrow) char[len + 1]);
+        if (!bigBuf) {
+            return 0;
+        }
+        str = bigBuf.get();
+        formatDouble(value, precision, str, len + 1);
+    }
+    char sign = spec.sign;
+    if (*str == '-') {
+        sign = '-';
+        ++str;
+        --len;
+    }
+    FormatSpec s = spec;
+    if (!isFormatDigit(*str)) {
+        s.zeroPad = false; // Not padding "nan" and "inf" with zeros
+    }
+    return writePadded(out, s, &sign, sign ? 1 : 0, str, len, true /* numeric */);
+}
+
+size_t writeArg(Print& out, const FormatSpec& spec, const FormatArg& arg) {
+    switch (arg.type) {
+    case FormatArgType::BOOL: {
+        if (!spec.type || spec.type == 's') {
+            const char* const str = arg.u ? "true" : "false";
+            return writePadded(out, spec, nullptr, 0, str, strlen(str), false /* numeric */);
+        }
+        return writeInteger(out, spec, arg.u, false /* negative */);
+    }
+    case FormatArgType::CHAR: {
+        if (!spec.type || spec.type == 'c') {
+            const char c = arg.i;
+            return writePadded(out, spec, nullptr, 0, &c, 1, false /* numeric */);
+        }
+        // arg.i can only be negative if char is signed
+        if (arg.i < 0) {
+            return writeInteger(out, spec, 0ull - arg.u, true /* negative */);
+        }
+        return writeInteger(out, spec, arg.u, false /* negative */);
+    }
+    case FormatArgType::INT:
+    case FormatArgType::UINT: {
+        if (spec.type == 'c') {
+            const char c = arg.i;
+            return writePadded(out, spec, nullptr, 0, &c, 1, false /* numeric */);
+        }
+        if (arg.type == FormatArgType::INT && arg.i < 0) {
+            return writeInteger(out, spec, 0ull - arg.u, true /* negative */);
+        }
+        return writeInteger(out, spec, arg.u, false /* negative */);
+    }
+    case FormatArgType::DOUBLE:
+        return writeDouble(out, spec, arg.d);
+    case FormatArgType::STRING: {
+        size_t len = arg.s.size;
+        if (spec.precision >= 0 && (size_t)spec.precision < len) {
+            len = spec.precision;
+        }
+        return writePadded(out, spec, nullptr, 0, arg.s.data, len, false /* numeric */);
+    }
+    case FormatArgType::POINTER: {
+        char buf[MAX_INTEGER_STRING_LENGTH + 1];
+        const size_t len = formatUnsigned((uintptr_t)arg.p, buf, 16);
+        return writePadded(out, spec, "0x", 2, buf, len, true /* numeric */);
+    }
+    default:
+        return 0;
+    }
+}
+
+} // namespace
+
+size_t formatPieces(Print& out, const char* fmt, const FormatPiece* pieces, size_t pieceCount, const FormatArg* args) {
+    size_t n = 0;
+    for (size_t i = 0; i < pieceCount; ++i) {
+        const FormatPiece& p = pieces[i];
+        n += writeData(out, fmt + p.offset, p.length);
+        if (p.arg >= 0) {
+            n += writeArg(out, p.spec, args[p.arg]);
+        }
+    }
+    return n;
+}
+
+} // namespace detail
+
+} // namespace spark
@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_FORMAT_H
+#define SPARK_WIRING_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "spark_wiring_print.h"
+#include "spark_wiring_string.h"
+#include "spark_wiring_string_view.h"
+
+/**
+ * Define a format string for `spark::format()`.
+ *
+ * The format string is parsed at compile time. Errors in the format string, as well as a mismatch
+ * between the placeholders and the arguments passed to `format()`, are reported as compilation
+ * errors.
+ *
+ * @param str String literal.
+ */
+#define PARTICLE_FMT(str) \
+        ([]() { \
+            struct FormatString: ::spark::detail::FormatStringBase { \
+                static constexpr const char* data() { \
+                    return str; \
+                } \
+                static constexpr size_t size() { \
+                    return sizeof(str) - 1; \
+                } \
+            }; \
+            return FormatString(); \
+        }())
+
+namespace spark {
+
+namespace detail {
+
+// Base class of the types defined by PARTICLE_FMT()
+struct FormatStringBase {
+};
+
+template<typename T>
+struct IsFormatString: std::is_base_of<FormatStringBase, T> {
+};
+
+enum class FormatArgType: uint8_t {
+    NONE,
+    BOOL,
+    CHAR,
+    INT,
+    UINT,
+    DOUBLE,
+    STRING,
+    POINTER
+};
+
+struct FormatStringArg {
+    const char* data;
+    size_t size;
+};
+
+// Type-erased argument
+struct FormatArg {
+    FormatArgType type;
+    union {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void* p;
+        FormatStringArg s;
+    };
+};
+
+// Parsed replacement field: {[index][:[[fill]align][sign][#][0][width][.precision][type]]}
+struct FormatSpec {
+    char fill = ' ';
+    char align = 0; // '<', '>', '^' or 0
+    char sign = 0; // '+', ' ' or 0
+    char type = 0;
+    bool alternate = false;
+    bool zeroPad = false;
+    uint16_t width = 0;
+    int16_t precision = -1;
+};
+
+// A format string is parsed into pieces, each consisting of a literal text followed by an optional
+// replacement field
+struct FormatPiece {
+    uint16_t offset = 0; // Offset of the literal text
+    uint16_t length = 0; // Length of the literal text
+    int16_t arg = -1; // Index of the argument, or -1 if the piece has no replacement field
+    FormatSpec spec;
+};
+
+struct FormatInfo {
+    int pieceCount = 0;
+    int argCount = 0;
+    bool valid = true;
+};
+
+template<size_t N>
+struct FormatPieces {
+    FormatPiece pieces[N];
+};
+
+constexpr bool isFormatDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool isFormatAlign(char c) {
+    return c == '<' || c == '>' || c == '^';
+}
+
+constexpr int parseFormatNumber(const char* s, size_t n, size_t& i, int maxValue) {
+    int v = 0;
+    while (i < n && isFormatDigit(s[i])) {
+        v = v * 10 + (s[i] - '0');
+        if (v > maxValue) {
+            return -1;
+        }
+        ++i;
+    }
+    return v;
+}
+
+// Parses the specification of a replacement field up to the closing brace
+constexpr bool parseFormatSpec(const char* s, size_t n, size_t& i, FormatSpec& spec) {
+    if (i + 1 < n && isFormatAlign(s[i + 1]) && s[i] != '{' && s[i] != '}') {
+        spec.fill = s[i];
+        spec.align = s[i + 1];
+        i += 2;
+    } else if (i < n && isFormatAlign(s[i])) {
+        spec.align = s[i];
+        ++i;
+    }
+    if (i < n && (s[i] == '+' || s[i] == '-' || s[i] == ' ')) {
+        spec.sign = (s[i] == '-') ? 0 : s[i];
+        ++i;
+    }
+    if (i < n && s[i] == '#') {
+        spec.alternate = true;
+        ++i;
+    }
+    if (i < n && s[i] == '0') {
+        spec.zeroPad = true;
+        ++i;
+    }
+    const int width = parseFormatNumber(s, n, i, UINT16_MAX);
+    if (width < 0) {
+        return false;
+    }
+    spec.width = width;
+    if (i < n && s[i] == '.') {
+        ++i;
+        if (i == n || !isFormatDigit(s[i])) {
+            return false;
+        }
+        const int prec = parseFormatNumber(s, n, i, INT16_MAX);
+        if (prec < 0) {
+            return false;
+        }
+        spec.precision = prec;
+    }
+    if (i < n && s[i] != '}') {
+        spec.type = s[i];
+        ++i;
+    }
+    return true;
+}
+
+// Parses a format string. If pieces is null, only the number of pieces is determined
+constexpr FormatInfo parseFormat(const char* s, size_t n, FormatPiece* pieces) {
+    FormatInfo info;
+    if (n > UINT16_MAX) {
+        info.valid = false;
+        return info;
+    }
+    size_t literal = 0; // Start of the current literal text
+    size_t i = 0;
+    int nextArg = 0;
+    bool autoIndex = false;
+    bool manualIndex = false;
+    while (i < n) {
+        if (s[i] != '{' && s[i] != '}') {
+            ++i;
+            continue;
+        }
+        FormatPiece p;
+        p.offset = literal;
+        p.length = i - literal;
+        if (i + 1 < n && s[i + 1] == s[i]) {
+            // Escaped brace. The first brace becomes the last character of the literal text
+            ++p.length;
+            i += 2;
+        } else if (s[i] == '}') {
+            info.valid = false;
+            return info;
+        } else {
+            ++i;
+            if (i < n && isFormatDigit(s[i])) {
+                p.arg = parseFormatNumber(s, n, i, INT16_MAX - 1);
+                manualIndex = true;
+            } else {
+                p.arg = nextArg++;
+                autoIndex = true;
+            }
+            if (p.arg < 0 || (autoIndex && manualIndex)) {
+                info.valid = false;
+                return info;
+            }
+            if (i < n && s[i] == ':') {
+                ++i;
+                if (!parseFormatSpec(s, n, i, p.spec)) {
+                    info.valid = false;
+                    return info;
+                }
+            }
+            if (i == n || s[i] != '}') {
+                info.valid = false;
+                return info;
+            }
+            ++i;
+            if (p.arg >= info.argCount) {
+                info.argCount = p.arg + 1;
+            }
+        }
+        if (pieces) {
+            pieces[info.pieceCount] = p;
+        }
+        ++info.pieceCount;
+        literal = i;
+    }
+    if (literal < n) {
+        if (pieces) {
+            FormatPiece p;
+            p.offset = literal;
+            p.length = n - literal;
+            pieces[info.pieceCount] = p;
+        }
+        ++info.pieceCount;
+    }
+    return info;
+}
+
+template<size_t N>
+constexpr FormatPieces<N> parseFormatPieces(const char* s, size_t n) {
+    FormatPieces<N> p = {};
+    parseFormat(s, n, p.pieces);
+    return p;
+}
+
+template<typename FormatT>
+struct ParsedFormat {
+    static constexpr FormatInfo INFO = parseFormat(FormatT::data(), FormatT::size(), nullptr);
+    static constexpr FormatPieces<(INFO.pieceCount > 0) ? INFO.pieceCount : 1> PIECES =
+            parseFormatPieces<(INFO.pieceCount > 0) ? INFO.pieceCount : 1>(FormatT::data(), FormatT::size());
+};
+
+constexpr bool isFormatIntegerType(char t) {
+    return t == 'd' || t == 'x' || t == 'X' || t == 'b' || t == 'o';
+}
+
+constexpr bool checkFormatSpec(const FormatSpec& spec, FormatArgType type) {
+    const char t = spec.type;
+    switch (type) {
+    case FormatArgType::BOOL:
+        return t == 0 || t == 's' || isFormatIntegerType(t);
+    case FormatArgType::CHAR:
+        return t == 0 || t == 'c' || isFormatIntegerType(t);
+    case FormatArgType::INT:
+    case FormatArgType::UINT:
+        return (t == 0 || t == 'c' || isFormatIntegerType(t)) && spec.precision < 0;
+    case FormatArgType::DOUBLE:
+        return t == 0 || t == 'f' || t == 'F';
+    case FormatArgType::STRING:
+        return (t == 0 || t == 's') && !spec.sign && !spec.alternate && !spec.zeroPad;
+    case FormatArgType::POINTER:
+        return (t == 0 || t == 'p') && spec.precision < 0;
+    default:
+        return false;
+    }
+}
+
+constexpr bool checkFormatArgs(const FormatPiece* pieces, int pieceCount, const FormatArgType* types, int argCount) {
+    for (int i = 0; i < pieceCount; ++i) {
+        const int arg = pieces[i].arg;
+        if (arg >= 0 && arg < argCount && !checkFormatSpec(pieces[i].spec, types[arg])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T>
+struct FormatDependentFalse: std::false_type {
+};
+
+// Conversion of the supported argument types to FormatArg
+template<typename T, typename EnableT = void>
+struct FormatArgTraits {
+    static_assert(FormatDependentFalse<T>::value, "Unsupported argument type");
+};
+
+template<>
+struct FormatArgTraits<bool> {
+    static constexpr FormatArgType TYPE = FormatArgType::BOOL;
+    static FormatArg make(bool val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.u = val;
+        return a;
+    }
+};
+
+template<>
+struct FormatArgTraits<char> {
+    static constexpr FormatArgType TYPE = FormatArgType::CHAR;
+    static FormatArg make(char val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.i = val;
+        return a;
+    }
+};
+
+template<typename T>
+struct FormatArgTraits<T, std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value &&
+        !std::is_same<T, char>::value>> {
+    static constexpr FormatArgType TYPE = FormatArgType::INT;
+    static FormatArg make(T val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.i = val;
+        return a;
+    }
+};
+
+template<typename T>
+struct FormatArgTraits<T, std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value &&
+        !std::is_same<T, bool>::value && !std::is_same<T, char>::value>> {
+    static constexpr FormatArgType TYPE = FormatArgType::UINT;
+    static FormatArg make(T val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.u = val;
+        return a;
+    }
+};
+
+template<typename T>
+struct FormatArgTraits<T, std::enable_if_t<std::is_enum<T>::value>> {
+    typedef FormatArgTraits<std::underlying_type_t<T>> Traits;
+    static constexpr FormatArgType TYPE = Traits::TYPE;
+    static FormatArg make(T val) {
+        return Traits::make((std::underlying_type_t<T>)val);
+    }
+};
+
+template<typename T>
+struct FormatArgTraits<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+    static constexpr FormatArgType TYPE = FormatArgType::DOUBLE;
+    static FormatArg make(T val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.d = val;
+        return a;
+    }
+};
+
+template<>
+struct FormatArgTraits<StringView> {
+    static constexpr FormatArgType TYPE = FormatArgType::STRING;
+    static FormatArg make(StringView val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.s.data = val.data();
+        a.s.size = val.size();
+        return a;
+    }
+};
+
+template<>
+struct FormatArgTraits<String>: FormatArgTraits<StringView> {
+};
+
+template<>
+struct FormatArgTraits<const char*> {
+    static constexpr FormatArgType TYPE = FormatArgType::STRING;
+    static FormatArg make(const char* val) {
+        return FormatArgTraits<StringView>::make(val ? StringView(val) : StringView("(null)"));
+    }
+};
+
+template<>
+struct FormatArgTraits<char*>: FormatArgTraits<const char*> {
+};
+
+template<typename T>
+struct FormatArgTraits<T, std::enable_if_t<(std::is_pointer<T>::value && !std::is_same<T, const char*>::value &&
+        !std::is_same<T, char*>::value) || std::is_same<T, std::nullptr_t>::value>> {
+    static constexpr FormatArgType TYPE = FormatArgType::POINTER;
+    static FormatArg make(T val) {
+        FormatArg a;
+        a.type = TYPE;
+        a.p = (const void*)val;
+        return a;
+    }
+};
+
+size_t formatPieces(Print& out, const char* fmt, const FormatPiece* pieces, size_t pieceCount, const FormatArg* args);
+
+} // namespace detail
+
+/**
+ * Format a string and write it to an output.
+ *
+ * The format string uses the syntax of the `{fmt}` library and `std::format()`. Each replacement
+ * field has the form `{[index][:[[fill]align][sign][#][0][width][.precision][type]]}`:
+ *
+ * - `index`: Index of the argument. Either all fields or none of them need to specify an index.
+ * - `fill`, `align`: Padding character and alignment: `<` (left), `>` (right) or `^` (center).
+ *   Numbers are aligned to the right by default, other values are aligned to the left.
+ * - `sign`: `+` to print a sign for non-negative numbers too, or a space to print a space instead.
+ * - `#`: Print a base prefix for integers (`0x`, `0X`, `0b` or `0`).
+ * - `0`: Pad numbers with zeros after the sign and the base prefix.
+ * - `width`: Minimum width of the field.
+ * - `precision`: Number of digits after the decimal point for floating point numbers (6 by
+ *   default), or the maximum number of characters for strings.
+ * - `type`: `d`, `x`, `X`, `b`, `o` or `c` for integers, characters and booleans, `f` for
+ *   floating point numbers, `s` for strings and booleans, and `p` for pointers.
+ *
+ * Braces can be escaped by doubling them. The supported argument types are integers, booleans,
+ * characters, floating point numbers, C strings, `String`, `StringView` and pointers.
+ *
+ * The format string is parsed at compile time, so the formatting is performed in a single pass
+ * over the parsed pieces of the string. Floating point numbers are formatted the same way as by
+ * `printf("%.*f")`.
+ *
+ * Example:
+ * ```
+ * format(Serial, PARTICLE_FMT("{}: {:.1f} C, status 0x{:04x}\r\n"), name, temp, status);
+ * ```
+ *
+ * @param out Output.
+ * @param fmt Format string defined with `PARTICLE_FMT()`.
+ * @param args Arguments.
+ * @return Number of characters written.
+ */
+template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<detail::IsFormatString<FormatT>::value>>
+inline size_t format(Print& out, FormatT fmt, const ArgsT&... args) {
+    typedef detail::ParsedFormat<FormatT> Parsed;
+    static_assert(Parsed::INFO.valid, "Invalid format string");
+    static_assert(!Parsed::INFO.valid || Parsed::INFO.argCount == sizeof...(ArgsT), "Number of arguments doesn't match the format string");
+    constexpr detail::FormatArgType types[] = { detail::FormatArgTraits<std::decay_t<ArgsT>>::TYPE..., detail::FormatArgType::NONE };
+    static_assert(detail::checkFormatArgs(Parsed::PIECES.pieces, Parsed::INFO.pieceCount, types, sizeof...(ArgsT)),
+            "Format specification doesn't match the argument type");
+    const detail::FormatArg a[] = { detail::FormatArgTraits<std::decay_t<ArgsT>>::make(args)..., detail::FormatArg() };
+    return detail::formatPieces(out, FormatT::data(), Parsed::PIECES.pieces, Parsed::INFO.pieceCount, a);
+}
+
+/**
+ * Format a string.
+ *
+ * @param fmt Format string defined with `PARTICLE_FMT()`.
+ * @param args Arguments.
+ * @return Formatted string, or an empty string on a memory allocation error.
+ *
+ * @see `format(Print&, FormatT, const ArgsT&...)`
+ */
+template<typename FormatT, typename... ArgsT, typename EnableT = std::enable_if_t<detail::IsFormatString<FormatT>::value>>
+inline String format(FormatT fmt, const ArgsT&... args) {
+    String s;
+    particle::OutputStringStream out(s);
+    format(out, fmt, args...);
+    if (out.getWriteError()) {
+        return String();
+    }
+    return s;
+}
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::format;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_FORMAT_H
@@ -0,0 +1,760 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <new>
+#include <type_traits>
+#include <cstring>
+#include <cstdint>
+
+#include "spark_wiring_vector.h"
+#include "spark_wiring_string.h"
+
+#include "debug.h"
+
+namespace particle {
+
+namespace detail {
+
+inline uint32_t hashBytes(const void* data, size_t size) {
+    const uint64_t m = 0x9e3779b97f4a7c15ull;
+    uint64_t h = size * m;
+    auto p = (const uint8_t*)data;
+    while (size >= 8) {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        h = (h ^ v) * m;
+        h ^= h >> 29;
+        p += 8;
+        size -= 8;
+    }
+    if (size > 0) {
+        uint64_t v = 0;
+        memcpy(&v, p, size);
+        h = (h ^ v) * m;
+        h ^= h >> 29;
+    }
+    h *= m;
+    return h >> 32;
+}
+
+inline uint32_t hashInteger(uint64_t val) {
+    val ^= val >> 33;
+    val *= 0xff51afd7ed558ccdull;
+    val ^= val >> 33;
+    return val;
+}
+
+} // namespace detail
+
+/**
+ * Hash function used by `HashMap`.
+ *
+ * Specializations are provided for integer and enum types, and for `String`. The `String` hash can
+ * also be computed for a C string or a `StringView`, which allows looking up entries without creating
+ * a temporary `String` object.
+ *
+ * @tparam T Key type.
+ */
+template<typename T, typename EnableT = void>
+struct Hash;
+
+template<typename T>
+struct Hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+    uint32_t operator()(T val) const {
+        return detail::hashInteger((uint64_t)val);
+    }
+};
+
+template<>
+struct Hash<String> {
+    uint32_t operator()(const String& str) const {
+        return detail::hashBytes(str.c_str(), str.length());
+    }
+
+    uint32_t operator()(const char* str) const {
+        return detail::hashBytes(str, strlen(str));
+    }
+
+    uint32_t operator()(StringView str) const {
+        return detail::hashBytes(str.data(), str.size());
+    }
+};
+
+/**
+ * An unordered associative container with unique keys.
+ *
+ * Internally, `HashMap` stores its entries in a dynamically allocated array in insertion order,
+ * and maintains a separate open addressing hash table with Robin Hood probing that maps hashes of
+ * the keys to positions in the array. Lookup, insertion and removal take amortized constant time.
+ *
+ * Removing an entry moves the last entry of the array in its place, which invalidates iterators
+ * pointing to that entry. Use `sort()` if the entries need to be iterated in key order.
+ *
+ * Keys are compared using `EqualT`, which is called with a key stored in the map as the first
+ * argument. The hash function and the equality predicate can accept types other than `KeyT`, e.g.
+ * `const char*` for a map with `String` keys, as long as equal keys have equal hashes.
+ *
+ * @tparam KeyT Key type.
+ * @tparam ValueT Value type.
+ * @tparam HashT Hash function type.
+ * @tparam EqualT Equality predicate type.
+ * @tparam AllocatorT Allocator type.
+ */
+template<typename KeyT, typename ValueT, typename HashT = Hash<KeyT>, typename EqualT = std::equal_to<>,
+        typename AllocatorT = spark::DefaultAllocator>
+class HashMap {
+public:
+    /**
+     * Key type.
+     */
+    typedef KeyT Key;
+
+    /**
+     * Value type.
+     */
+    typedef ValueT Value;
+
+    /**
+     * Entry type.
+     */
+    typedef std::pair<const KeyT, ValueT> Entry;
+
+    /**
+     * Array of entries.
+     */
+    typedef Vector<Entry, AllocatorT> Entries;
+
+    /**
+     * Iterator type.
+     */
+    typedef typename Entries::Iterator Iterator;
+
+    /**
+     * Constant interator type.
+     */
+    typedef typename Entries::ConstIterator ConstIterator;
+
+    /**
+     * Construct an empty map.
+     */
+    HashMap() :
+            slots_(nullptr),
+            slotCount_(0) {
+    }
+
+    /**
+     * Construct a map from an initializer list.
+     *
+     * @param entries Entries.
+     */
+    HashMap(std::initializer_list<Entry> entries) :
+            HashMap() {
+        HashMap map;
+        if (!map.reserve(entries.size())) {
+            return;
+        }
+        for (auto& e: entries) {
+            if (!map.set(e.first, e.second)) {
+                return;
+            }
+        }
+        swap(*this, map);
+    }
+
+    /**
+     * Copy constructor.
+     *
+     * @param map Map to copy.
+     */
+    HashMap(const HashMap& map) :
+            HashMap() {
+        if (map.entries_.isEmpty()) {
+            return;
+        }
+        HashMap m;
+        m.entries_ = map.entries_;
+        if (m.entries_.size() != map.entries_.size()) {
+            return;
+        }
+        m.slots_ = (Slot*)AllocatorT::malloc(map.slotCount_ * sizeof(Slot));
+        if (!m.slots_) {
+            return;
+        }
+        memcpy(m.slots_, map.slots_, map.slotCount_ * sizeof(Slot));
+        m.slotCount_ = map.slotCount_;
+        m.hash_ = map.hash_;
+        m.eq_ = map.eq_;
+        swap(*this, m);
+    }
+
+    /**
+     * Move constructor.
+     *
+     * @param map Map to move from.
+     */
+    HashMap(HashMap&& map) :
+            HashMap() {
+        swap(*this, map);
+    }
+
+    /**
+     * Destructor.
+     */
+    ~HashMap() {
+        AllocatorT::free(slots_);
+    }
+
+    ///@{
+    /**
+     * Add or update an entry.
+     *
+     * @param key Key.
+     * @param val Value.
+     * @return `true` if the entry was added or updated, or `false` on a memory allocation error.
+     */
+    template<typename T>
+    bool set(const T& key, ValueT val) {
+        auto r = insert(key, std::move(val));
+        if (r.first == entries_.end()) {
+            return false;
+        }
+        return true;
+    }
+
+    bool set(KeyT&& key, ValueT val) {
+        auto r = insert(std::move(key), std::move(val));
+        if (r.first == entries_.end()) {
+            return false;
+        }
+        return true;
+    }
+    ///@}
+
+    /**
+     * Get the value of an entry.
+     *
+     * A default-constructed value is returned if an entry with the given key cannot be found.
+     *
+     * @param key Key.
+     * @return Value.
+     */
+    template<typename T>
+    ValueT get(const T& key) const {
+        auto it = find(key);
+        if (it == entries_.end()) {
+            return ValueT();
+        }
+        return it->second;
+    }
+
+    /**
+     * Get the value of an entry.
+     *
+     * @param key Key.
+     * @param defaultVal Value to return if an entry with the given key cannot be found.
+     * @return Value.
+     */
+    template<typename T>
+    ValueT get(const T& key, const ValueT& defaultVal) const {
+        auto it = find(key);
+        if (it == entries_.end()) {
+            return defaultVal;
+        }
+        return it->second;
+    }
+
+    /**
+     * Remove an entry.
+     *
+     * @param key Key.
+     * @return `true` if the entry was removed, otherwise `false`.
+     */
+    template<typename T>
+    bool remove(const T& key) {
+        const int slot = findSlot(key, hash_(key));
+        if (slot < 0) {
+            return false;
+        }
+        removeSlot(slot);
+        return true;
+    }
+
+    /**
+     * Check if the map contains an entry.
+     *
+     * @param key Key.
+     * @return `true` if an entry with the given key is found, otherwise `false`.
+     */
+    template<typename T>
+    bool has(const T& key) const {
+        return findSlot(key, hash_(key)) >= 0;
+    }
+
+    /**
+     * Get all entries of the map.
+     *
+     * @return Entries.
+     */
+    const Entries& entries() const {
+        return entries_;
+    }
+
+    /**
+     * Get the number of entries in the map.
+     *
+     * @return Number of entries.
+     */
+    int size() const {
+        return entries_.size();
+    }
+
+    /**
+     * Check if the map is empty.
+     *
+     * @return `true` if the map is empty, otherwise `false`.
+     */
+    bool isEmpty() const {
+        return entries_.isEmpty();
+    }
+
+    /**
+     * Reserve memory for the specified number of entries.
+     *
+     * @param count Number of entries.
+     * @return `true` on success, or `false` on a memory allocation error.
+     */
+    bool reserve(int count) {
+        if (!entries_.reserve(count)) {
+            return false;
+        }
+        if (maxLoad(slotCount_) < count && !rehash(slotCountFor(count))) {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Get the number of entries that can be stored without reallocating memory.
+     *
+     * @return Number of entries.
+     */
+    int capacity() const {
+        return std::min(entries_.capacity(), maxLoad(slotCount_));
+    }
+
+    /**
+     * Reduce the capacity of the map to its actual size.
+     *
+     * @return `true` on success, or `false` on a memory allocation error.
+     */
+    bool trimToSize() {
+        if (!entries_.trimToSize()) {
+            return false;
+        }
+        const int n = entries_.isEmpty() ? 0 : slotCountFor(entries_.size());
+        if (n != slotCount_ && !rehash(n)) {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Remove all entries.
+     */
+    void clear() {
+        entries_.clear();
+        for (int i = 0; i < slotCount_; ++i) {
+            slots_[i].index = -1;
+        }
+    }
+
+    /**
+     * Sort the entries of the map by key.
+     *
+     * The order of the entries is preserved until an entry is removed from the map. New entries
+     * are added at the end.
+     *
+     * @param cmp Comparator.
+     * @return `true` on success, or `false` on a memory allocation error.
+     */
+    template<typename CompareT = std::less<KeyT>>
+    bool sort(CompareT cmp = CompareT()) {
+        Vector<int> order;
+        if (!order.resize(entries_.size())) {
+            return false;
+        }
+        for (int i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [this, &cmp](int i1, int i2) {
+            return cmp(this->entries_[i1].first, this->entries_[i2].first);
+        });
+        Entries entries;
+        if (!entries.reserve(entries_.capacity())) {
+            return false;
+        }
+        for (int i: order) {
+            entries.append(std::move(entries_[i]));
+        }
+        swap(entries_, entries);
+        return rehash(slotCount_);
+    }
+
+    ///@{
+    /**
+     * Get an iterator pointing to the first entry of the map.
+     *
+     * @return Iterator.
+     */
+    Iterator begin() {
+        return entries_.begin();
+    }
+
+    ConstIterator begin() const {
+        return entries_.begin();
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Get an iterator pointing to the entry following the last entry of the map.
+     *
+     * @return Iterator.
+     */
+    Iterator end() {
+        return entries_.end();
+    }
+
+    ConstIterator end() const {
+        return entries_.end();
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Find an entry.
+     *
+     * If an entry with the given key cannot be found, an iterator pointing to the entry following
+     * the last entry of the map is returned.
+     *
+     * @param key Key.
+     * @return Iterator pointing to the entry.
+     */
+    template<typename T>
+    Iterator find(const T& key) {
+        const int slot = findSlot(key, hash_(key));
+        if (slot < 0) {
+            return entries_.end();
+        }
+        return entries_.begin() + slots_[slot].index;
+    }
+
+    template<typename T>
+    ConstIterator find(const T& key) const {
+        const int slot = findSlot(key, hash_(key));
+        if (slot < 0) {
+            return entries_.end();
+        }
+        return entries_.begin() + slots_[slot].index;
+    }
+    ///@}
+
+    ///@{
+    /**
+     * Add or update an entry.
+     *
+     * On a memory allocation error, an iterator pointing to the entry following the last entry of
+     * the map is returned.
+     *
+     * @param key Key.
+     * @param val Value.
+     * @return `std::pair` where `first` is an iterator pointing to the entry, and `second` is set
+     *         to `true` if the entry was inserted, or `false` if it was updated.
+     */
+    template<typename T>
+    std::pair<Iterator, bool> insert(const T& key, ValueT val) {
+        const uint32_t h = hash_(key);
+        const int slot = findSlot(key, h);
+        if (slot >= 0) {
+            auto it = entries_.begin() + slots_[slot].index;
+            it->second = std::move(val);
+            return std::make_pair(it, false);
+        }
+        return insertEntry(h, KeyT(key), std::move(val));
+    }
+
+    std::pair<Iterator, bool> insert(KeyT&& key, ValueT val) {
+        const uint32_t h = hash_(key);
+        const int slot = findSlot(key, h);
+        if (slot >= 0) {
+            auto it = entries_.begin() + slots_[slot].index;
+            it->second = std::move(val);
+            return std::make_pair(it, false);
+        }
+        return insertEntry(h, std::move(key), std::move(val));
+    }
+    ///@}
+
+    /**
+     * Remove an entry.
+     *
+     * The last entry of the map is moved in place of the removed entry.
+     *
+     * @param pos Iterator pointing to the entry to be removed.
+     * @return Iterator pointing to the entry that took the place of the removed entry.
+     */
+    Iterator erase(ConstIterator pos) {
+        const int index = pos - entries_.begin();
+        removeSlot(slotOf(index));
+        return entries_.begin() + index;
+    }
+
+    ///@{
+    /**
+     * Get a reference to the value of an entry.
+     *
+     * The entry is created if it doesn't exist.
+     *
+     * @note The device will panic if it fails to allocate memory for the new entry. Use `set()` or
+     * `insert()` if you need more control over how memory allocation errors are handled.
+     *
+     * @param key Key.
+     * @return Value.
+     */
+    template<typename T>
+    ValueT& operator[](const T& key) {
+        const uint32_t h = hash_(key);
+        const int slot = findSlot(key, h);
+        if (slot >= 0) {
+            return entries_.at(slots_[slot].index).second;
+        }
+        auto r = insertEntry(h, KeyT(key), ValueT());
+        SPARK_ASSERT(r.first != entries_.end());
+        return r.first->second;
+    }
+
+    ValueT& operator[](KeyT&& key) {
+        const uint32_t h = hash_(key);
+        const int slot = findSlot(key, h);
+        if (slot >= 0) {
+            return entries_.at(slots_[slot].index).second;
+        }
+        auto r = insertEntry(h, std::move(key), ValueT());
+        SPARK_ASSERT(r.first != entries_.end());
+        return r.first->second;
+    }
+    ///@}
+
+    /**
+     * Assignment operator.
+     *
+     * @param map Map to assign from.
+     * @return This map.
+     */
+    HashMap& operator=(HashMap map) {
+        swap(*this, map);
+        return *this;
+    }
+
+    /**
+     * Comparison operators.
+     *
+     * Two maps are equal if they contain equal sets of entries, regardless of their order.
+     */
+    ///@{
+    bool operator==(const HashMap& map) const {
+        if (entries_.size() != map.entries_.size()) {
+            return false;
+        }
+        for (auto& e: entries_) {
+            auto it = map.find(e.first);
+            if (it == map.entries_.end() || !(it->second == e.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool operator!=(const HashMap& map) const {
+        return !operator==(map);
+    }
+    ///@}
+
+    friend void swap(HashMap& map1, HashMap& map2) {
+        using std::swap; // For ADL
+        swap(map1.entries_, map2.entries_);
+        swap(map1.slots_, map2.slots_);
+        swap(map1.slotCount_, map2.slotCount_);
+        swap(map1.hash_, map2.hash_);
+        swap(map1.eq_, map2.eq_);
+    }
+
+private:
+    // Slot of the hash table
+    struct Slot {
+        uint32_t hash; // Hash of the key
+        int index; // Index of the entry, or -1 if the slot is empty
+    };
+
+    Entries entries_;
+    Slot* slots_;
+    int slotCount_; // Always a power of two
+    HashT hash_;
+    EqualT eq_;
+
+    // Maximum load factor is 7/8
+    static int maxLoad(int slotCount) {
+        return slotCount - slotCount / 8;
+    }
+
+    static int slotCountFor(int count) {
+        int n = 8;
+        while (maxLoad(n) < count) {
+            n *= 2;
+        }
+        return n;
+    }
+
+    int probeDistance(uint32_t hash, int slot) const {
+        return (slot - (int)(hash & (slotCount_ - 1))) & (slotCount_ - 1);
+    }
+
+    template<typename T>
+    int findSlot(const T& key, uint32_t hash) const {
+        if (!slotCount_) {
+            return -1;
+        }
+        const int mask = slotCount_ - 1;
+        int slot = hash & mask;
+        for (int dist = 0;; ++dist) {
+            const Slot& s = slots_[slot];
+            if (s.index < 0 || probeDistance(s.hash, slot) < dist) {
+                return -1;
+            }
+            if (s.hash == hash && eq_(entries_[s.index].first, key)) {
+                return slot;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    // Find the slot that refers to the entry with the given index
+    int slotOf(int index) const {
+        const int mask = slotCount_ - 1;
+        int slot = hash_(entries_[index].first) & mask;
+        while (slots_[slot].index != index) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void insertSlot(uint32_t hash, int index) {
+        const int mask = slotCount_ - 1;
+        Slot s = { hash, index };
+        int slot = hash & mask;
+        for (int dist = 0;; ++dist) {
+            Slot& cur = slots_[slot];
+            if (cur.index < 0) {
+                cur = s;
+                return;
+            }
+            const int d = probeDistance(cur.hash, slot);
+            if (d < dist) {
+                std::swap(cur, s);
+                dist = d;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    // Remove the slot using backward shift deletion, and move the last entry in place of the
+    // entry referred to by the slot
+    void removeSlot(int slot) {
+        const int mask = slotCount_ - 1;
+        const int index = slots_[slot].index;
+        for (;;) {
+            const int next = (slot + 1) & mask;
+            const Slot& s = slots_[next];
+            if (s.index < 0 || probeDistance(s.hash, next) == 0) {
+                break;
+            }
+            slots_[slot] = s;
+            slot = next;
+        }
+        slots_[slot].index = -1;
+        const int last = entries_.size() - 1;
+        if (index != last) {
+            slots_[slotOf(last)].index = index;
+            Entry e = entries_.takeLast();
+            Entry* p = &entries_.at(index);
+            p->~Entry();
+            new(p) Entry(std::move(e));
+        } else {
+            entries_.removeAt(last);
+        }
+    }
+
+    std::pair<Iterator, bool> insertEntry(uint32_t hash, KeyT&& key, ValueT&& val) {
+        const int n = entries_.size() + 1;
+        if (maxLoad(slotCount_) < n && !rehash(slotCountFor(std::max(n, slotCount_)))) {
+            return std::make_pair(entries_.end(), false);
+        }
+        if (!entries_.append(std::make_pair(std::move(key), std::move(val)))) {
+            return std::make_pair(entries_.end(), false);
+        }
+        insertSlot(hash, n - 1);
+        return std::make_pair(entries_.end() - 1, true);
+    }
+
+    bool rehash(int slotCount) {
+        Slot* slots = nullptr;
+        if (slotCount > 0) {
+            if (slotCount == slotCount_) {
+                slots = slots_;
+            } else {
+                slots = (Slot*)AllocatorT::malloc(slotCount * sizeof(Slot));
+                if (!slots) {
+                    return false;
+                }
+            }
+            for (int i = 0; i < slotCount; ++i) {
+                slots[i].index = -1;
+            }
+        }
+        if (slots != slots_) {
+            AllocatorT::free(slots_);
+            slots_ = slots;
+        }
+        slotCount_ = slotCount;
+        for (int i = 0; i < entries_.size(); ++i) {
+            insertSlot(hash_(entries_[i].first), i);
+        }
+        return true;
+    }
+};
+
+} // namespace particle
+
+template<typename KeyT, typename ValueT, typename HashT, typename EqualT, typename AllocatorT>
+struct spark::IsTriviallyRelocatable<particle::HashMap<KeyT, ValueT, HashT, EqualT, AllocatorT>>:
+        std::conjunction<spark::IsTriviallyRelocatable<HashT>, spark::IsTriviallyRelocatable<EqualT>> {
+};
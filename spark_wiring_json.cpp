@@ -16,6 +16,7 @@
  */
 
 #include "spark_wiring_json.h"
+#include "string_convert.h"
 
 #include <algorithm>
 #include <limits>
@@ -243,7 +244,7 @@ spark::JSONType spark::JSONValue::type() const {
     }
 }
 
-spark::JSONValue spark::JSONValue::parse(char *json, size_t size) {
+spark::JSONValue spark::JSONValue::parse(char *json, size_t size, unsigned flags) {
     detail::JSONDataPtr d(new(std::nothrow) detail::JSONData);
     if (!d) {
         return JSONValue();
@@ -266,13 +267,13 @@ spark::JSONValue spark::JSONValue::parse(char *json, size_t size) {
     } else {
         d->json = json;
     }
-    if (!stringize(d->tokens, tokenCount, d->json)) {
+    if (!stringize(d->tokens, tokenCount, d->json, flags)) {
         return JSONValue();
     }
     return JSONValue(t, d);
 }
 
-spark::JSONValue spark::JSONValue::parseCopy(const char *json, size_t size) {
+spark::JSONValue spark::JSONValue::parseCopy(const char *json, size_t size, unsigned flags) {
     detail::JSONDataPtr d(new(std::nothrow) detail::JSONData);
     if (!d) {
         return JSONValue();
@@ -287,7 +288,7 @@ spark::JSONValue spark::JSONValue::parseCopy(const char *json, size_t size) {
     }
     memcpy(d->json, json, size); // TODO: Copy only token data
     d->freeJson = true;
-    if (!stringize(d->tokens, tokenCount, d->json)) {
+    if (!stringize(d->tokens, tokenCount, d->json, flags)) {
         return JSONValue();
     }
     return JSONValue(d->tokens, d);
@@ -314,15 +315,17 @@ bool spark::JSONValue::tokenize(const char *json, size_t size, jsmntok_t **token
     return true;
 }
 
-bool spark::JSONValue::stringize(jsmntok_t *t, size_t count, char *json) {
+bool spark::JSONValue::stringize(jsmntok_t *t, size_t count, char *json, unsigned flags) {
     const jsmntok_t* const end = t + count;
     while (t != end) {
-        if (t->type == JSMN_STRING) {
-            if (!unescape(t, json)) {
+        if (t->type == JSMN_STRING || t->type == JSMN_PRIMITIVE) {
+            if (t->type == JSMN_STRING && !unescape(t, json)) {
                 return false; // Malformed string
             }
-            json[t->end] = '\0';
-        } else if (t->type == JSMN_PRIMITIVE) {
+            // Validate the value while it's still in the cache after unescaping
+            if ((flags & JSON_PARSE_VALIDATE_UTF8) && !isValidUtf8(json + t->start, t->end - t->start)) {
+                return false;
+            }
             json[t->end] = '\0';
         }
         ++t;
@@ -517,42 +520,48 @@ spark::JSONWriter& spark::JSONWriter::value(bool val) {
 
 spark::JSONWriter& spark::JSONWriter::value(int val) {
     writeSeparator();
-    printf("%d", val);
+    char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+    write(buf, particle::detail::formatInteger(val, buf));
     state_ = NEXT;
     return *this;
 }
 
 spark::JSONWriter& spark::JSONWriter::value(unsigned val) {
     writeSeparator();
-    printf("%u", val);
+    char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+    write(buf, particle::detail::formatInteger(val, buf));
     state_ = NEXT;
     return *this;
 }
 
 spark::JSONWriter& spark::JSONWriter::value(long val) {
     writeSeparator();
-    printf("%ld", val);
+    char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+    write(buf, particle::detail::formatInteger(val, buf));
     state_ = NEXT;
     return *this;
 }
 
 spark::JSONWriter& spark::JSONWriter::value(unsigned long val) {
     writeSeparator();
-    printf("%lu", val);
+    char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+    write(buf, particle::detail::formatInteger(val, buf));
     state_ = NEXT;
     return *this;
 }
 
 spark::JSONWriter& spark::JSONWriter::value(long long val) {
     writeSeparator();
-    printf("%lld", val);
+    char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+    write(buf, particle::detail::formatInteger(val, buf));
     state_ = NEXT;
     return *this;
 }
 
 spark::JSONWriter& spark::JSONWriter::value(unsigned long long val) {
     writeSeparator();
-    printf("%llu", val);
+    char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+    write(buf, particle::detail::formatInteger(val, buf));
     state_ = NEXT;
     return *this;
 }
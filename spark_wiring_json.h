@@ -45,6 +45,11 @@ enum JSONType {
     JSON_TYPE_OBJECT
 };
 
+// Flags controlling JSONValue::parse() and JSONValue::parseCopy()
+enum JSONParseFlag {
+    JSON_PARSE_VALIDATE_UTF8 = 0x01 // Fail if a string or primitive value is not valid UTF-8
+};
+
 class JSONString;
 class JSONArrayIterator;
 class JSONObjectIterator;
@@ -73,8 +78,8 @@ public:
 
     bool isValid() const;
 
-    static JSONValue parse(char *json, size_t size);
-    static JSONValue parseCopy(const char *json, size_t size);
+    static JSONValue parse(char *json, size_t size, unsigned flags = 0);
+    static JSONValue parseCopy(const char *json, size_t size, unsigned flags = 0);
     static JSONValue parseCopy(const char *json);
 
 private:
@@ -84,7 +89,7 @@ private:
     JSONValue(const jsmntok_t *token, detail::JSONDataPtr data);
 
     static bool tokenize(const char *json, size_t size, jsmntok_t **tokens, size_t *count);
-    static bool stringize(jsmntok_t *tokens, size_t count, char *json);
+    static bool stringize(jsmntok_t *tokens, size_t count, char *json, unsigned flags);
     static bool unescape(jsmntok_t *token, char *json);
 
     friend class JSONString;
@@ -102,6 +107,9 @@ public:
     size_t size() const;
     bool isEmpty() const;
 
+    StringView view() const;
+    bool isValidUtf8() const;
+
     bool operator==(const char *str) const;
     bool operator!=(const char *str) const;
     bool operator==(const String &str) const;
@@ -316,6 +324,14 @@ inline bool spark::JSONString::isEmpty() const {
     return !n_;
 }
 
+inline spark::StringView spark::JSONString::view() const {
+    return StringView(s_, n_);
+}
+
+inline bool spark::JSONString::isValidUtf8() const {
+    return spark::isValidUtf8(s_, n_);
+}
+
 inline bool spark::JSONString::operator==(const char *str) const {
     return strcmp(s_, str) == 0;
 }
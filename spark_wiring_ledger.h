@@ -186,7 +186,7 @@ public:
      *
      * @return Entries.
      */
-    const Vector<Entry>& entries() const {
+    const VariantMap::Entries& entries() const {
         return variantMap().entries();
     }
 
@@ -36,8 +36,9 @@ namespace particle {
  * @tparam KeyT Key type.
  * @tparam ValueT Value type.
  * @tparam CompareT Comparator type.
+ * @tparam AllocatorT Allocator type used for the array of entries.
  */
-template<typename KeyT, typename ValueT, typename CompareT = std::less<KeyT>>
+template<typename KeyT, typename ValueT, typename CompareT = std::less<KeyT>, typename AllocatorT = spark::DefaultAllocator>
 class Map {
 public:
     /**
@@ -60,15 +61,20 @@ public:
      */
     typedef std::pair<const KeyT, ValueT> Entry;
 
+    /**
+     * Array of entries.
+     */
+    typedef Vector<Entry, AllocatorT> Entries;
+
     /**
      * Iterator type.
      */
-    typedef typename Vector<Entry>::Iterator Iterator;
+    typedef typename Entries::Iterator Iterator;
 
     /**
      * Constant interator type.
      */
-    typedef typename Vector<Entry>::ConstIterator ConstIterator;
+    typedef typename Entries::ConstIterator ConstIterator;
 
     /**
      * Construct an empty map.
@@ -82,7 +88,7 @@ public:
      */
     Map(std::initializer_list<Entry> entries) :
             Map() {
-        Map<KeyT, ValueT> map;
+        Map map;
         if (!map.reserve(entries.size())) {
             return;
         }
@@ -217,7 +223,7 @@ public:
      *
      * @return Entries.
      */
-    const Vector<Entry>& entries() const {
+    const Entries& entries() const {
         return entries_;
     }
 
@@ -494,8 +500,12 @@ public:
     }
 
 private:
-    Vector<Entry> entries_;
+    Entries entries_;
     CompareT cmp_;
 };
 
 } // namespace particle
+
+template<typename KeyT, typename ValueT, typename CompareT, typename AllocatorT>
+struct spark::IsTriviallyRelocatable<particle::Map<KeyT, ValueT, CompareT, AllocatorT>>: spark::IsTriviallyRelocatable<CompareT> {
+};
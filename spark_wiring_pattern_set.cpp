@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_pattern_set.h"
+
+namespace spark {
+
+PatternSet::PatternSet() :
+        classes_(),
+        startBytes_(),
+        startByte_(-1),
+        classCount_(0),
+        compiled_(false) {
+}
+
+bool PatternSet::add(StringView pattern) {
+    if (pattern.isEmpty()) {
+        return false;
+    }
+    String s(pattern);
+    if (s.length() != pattern.size() || !patterns_.append(std::move(s))) {
+        return false;
+    }
+    compiled_ = false;
+    return true;
+}
+
+bool PatternSet::compile() {
+    compiled_ = false;
+    // Bytes that don't occur in any of the patterns share class 0
+    memset(classes_, 0, sizeof(classes_));
+    memset(startBytes_, 0, sizeof(startBytes_));
+    classCount_ = 1;
+    int startCount = 0;
+    int stateCount = 1;
+    for (const String& p: patterns_) {
+        for (unsigned i = 0; i < p.length(); ++i) {
+            const unsigned char c = p.charAt(i);
+            if (!classes_[c]) {
+                classes_[c] = classCount_++;
+            }
+        }
+        const unsigned char c = p.charAt(0);
+        if (!startBytes_[c]) {
+            startBytes_[c] = 1;
+            startByte_ = c;
+            ++startCount;
+        }
+        stateCount += p.length();
+    }
+    if (startCount != 1) {
+        startByte_ = -1;
+    }
+    const int rowSize = ROW_TRANSITIONS + classCount_;
+    states_.clear();
+    if (!states_.reserve(stateCount * rowSize)) {
+        return false;
+    }
+    // Build a trie of the patterns. A transition to the root state denotes a missing edge at this
+    // stage, as no edge of the trie leads to the root
+    states_.append(rowSize, 0);
+    states_[ROW_PATTERN] = -1;
+    for (int i = 0; i < patterns_.size(); ++i) {
+        const String& p = patterns_.at(i);
+        int state = 0;
+        for (unsigned j = 0; j < p.length(); ++j) {
+            const int t = state + ROW_TRANSITIONS + classes_[(unsigned char)p.charAt(j)];
+            if (!states_[t]) {
+                const int next = states_.size();
+                states_.append(rowSize, 0);
+                states_[next + ROW_PATTERN] = -1;
+                states_[next + ROW_DEPTH] = j + 1;
+                states_[t] = next;
+            }
+            state = states_[t];
+        }
+        if (states_[state + ROW_PATTERN] < 0) {
+            states_[state + ROW_PATTERN] = i;
+        }
+    }
+    // Compute the failure links in breadth-first order and turn the trie into a DFA by replacing
+    // each missing edge with the respective edge of the failure state. The states are appended to
+    // the queue as they are visited, so a separate index is used as the head of the queue
+    Vector<int32_t> fail;
+    Vector<int32_t> queue;
+    if (!fail.resize(states_.size() / rowSize) || !queue.reserve(states_.size() / rowSize)) {
+        return false;
+    }
+    for (int c = 0; c < (int)classCount_; ++c) {
+        const int32_t next = states_[ROW_TRANSITIONS + c];
+        if (next) {
+            fail[next / rowSize] = 0;
+            queue.append(next);
+        }
+    }
+    for (int head = 0; head < queue.size(); ++head) {
+        int32_t* const row = &states_[queue[head]];
+        const int32_t* const failRow = &states_[fail[queue[head] / rowSize]];
+        // The longest pattern recognized in a state is either the one ending in that state or the
+        // longest pattern recognized in its failure state
+        if (row[ROW_PATTERN] < 0) {
+            row[ROW_PATTERN] = failRow[ROW_PATTERN];
+        }
+        for (int c = ROW_TRANSITIONS; c < rowSize; ++c) {
+            if (row[c]) {
+                fail[row[c] / rowSize] = failRow[c];
+                queue.append(row[c]);
+            } else {
+                row[c] = failRow[c];
+            }
+        }
+    }
+    compiled_ = true;
+    return true;
+}
+
+void PatternSet::clear() {
+    patterns_.clear();
+    states_.clear();
+    classCount_ = 0;
+    compiled_ = false;
+}
+
+PatternMatch PatternSet::find(StringView str, size_t fromIndex) const {
+    PatternMatch m = { -1, 0, -1 };
+    if (!compiled_) {
+        return m;
+    }
+    const int32_t* const states = states_.data();
+    const char* const s = str.data();
+    const size_t n = str.size();
+    size_t start = 0;
+    int32_t state = 0;
+    size_t i = fromIndex;
+    while (i < n) {
+        if (!state) {
+            // Skip the characters that don't start any of the patterns
+            if (startByte_ >= 0) {
+                const char* p = (const char*)memchr(s + i, startByte_, n - i);
+                if (!p) {
+                    break;
+                }
+                i = p - s;
+            } else {
+                while (!startBytes_[(unsigned char)s[i]]) {
+                    if (++i == n) {
+                        return m;
+                    }
+                }
+            }
+        }
+        state = states[state + ROW_TRANSITIONS + classes_[(unsigned char)s[i]]];
+        ++i;
+        // Any match ending at this or a later position starts no earlier than the prefix represented
+        // by the current state. Stop once such a match can no longer precede the one already found
+        const size_t pos = i - states[state + ROW_DEPTH];
+        if (m.index >= 0 && pos > start) {
+            break;
+        }
+        const int32_t p = states[state + ROW_PATTERN];
+        if (p >= 0) {
+            const int len = patterns_[p].length();
+            if (m.index < 0 || i - len < start || (i - len == start && len > m.length)) {
+                start = i - len;
+                m.index = start;
+                m.length = len;
+                m.pattern = p;
+            }
+        }
+    }
+    return m;
+}
+
+} // namespace spark
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_PATTERN_SET_H
+#define SPARK_WIRING_PATTERN_SET_H
+
+#include <cstdint>
+
+#include "spark_wiring_string.h"
+#include "spark_wiring_string_view.h"
+#include "spark_wiring_vector.h"
+
+namespace spark {
+
+/**
+ * A match found by `PatternSet::find()`.
+ */
+struct PatternMatch {
+    int index; ///< Index of the first character of the match, or -1 if no match was found.
+    int length; ///< Length of the match.
+    int pattern; ///< Index of the matched pattern.
+};
+
+/**
+ * A set of patterns that can be searched for in a string in a single pass.
+ *
+ * The patterns are compiled into an Aho-Corasick automaton. Compiling the set takes time and memory
+ * proportional to the total size of the patterns, after which the set can be used to search any
+ * number of strings. The automaton's transition table is indexed by byte classes rather than by
+ * bytes, so its size depends on the number of distinct characters used in the patterns. Characters
+ * that can't start a match are skipped without running the automaton.
+ *
+ * If several patterns match at different positions, the leftmost match is reported. If several
+ * patterns match at the same position, the longest match is reported. Matches don't overlap.
+ *
+ * Example:
+ * ```
+ * PatternSet secrets;
+ * secrets.add("password");
+ * secrets.add("token");
+ * secrets.compile();
+ *
+ * String line = "token=123";
+ * line.replaceAll(secrets, "***"); // "***=123"
+ * ```
+ */
+class PatternSet {
+public:
+    /**
+     * Construct an empty set.
+     */
+    PatternSet();
+
+    /**
+     * Add a pattern.
+     *
+     * The pattern is assigned the next available index, starting from 0. The set needs to be
+     * compiled again after new patterns are added.
+     *
+     * @param pattern Pattern. An empty pattern is not allowed.
+     * @return `true` if the pattern was added, or `false` if the pattern is empty or on a memory
+     *         allocation error.
+     */
+    bool add(StringView pattern);
+
+    /**
+     * Compile the set.
+     *
+     * @return `true` on success, or `false` on a memory allocation error.
+     */
+    bool compile();
+
+    /**
+     * Remove all patterns.
+     */
+    void clear();
+
+    /**
+     * Get a pattern.
+     *
+     * @param index Pattern index.
+     * @return Pattern.
+     */
+    const String& pattern(int index) const {
+        return patterns_.at(index);
+    }
+
+    /**
+     * Get the number of patterns in the set.
+     *
+     * @return Number of patterns.
+     */
+    int size() const {
+        return patterns_.size();
+    }
+
+    /**
+     * Check if the set is empty.
+     *
+     * @return `true` if the set is empty, otherwise `false`.
+     */
+    bool isEmpty() const {
+        return patterns_.isEmpty();
+    }
+
+    /**
+     * Check if the set is compiled.
+     *
+     * @return `true` if the set is compiled and its patterns can be searched for, otherwise `false`.
+     */
+    bool isCompiled() const {
+        return compiled_;
+    }
+
+    /**
+     * Find the first match in a string.
+     *
+     * @param str String.
+     * @param fromIndex Index of the character to start the search from.
+     * @return Match. The `index` field is set to -1 if no match was found or if the set is not
+     *         compiled.
+     */
+    PatternMatch find(StringView str, size_t fromIndex = 0) const;
+
+private:
+    // Each state of the automaton is stored as a row of the state table. The row contains the longest
+    // pattern recognized in the state, the length of the prefix represented by the state, and the
+    // transitions for each byte class. States are identified by the offsets of their rows
+    enum RowField {
+        ROW_PATTERN = 0,
+        ROW_DEPTH = 1,
+        ROW_TRANSITIONS = 2
+    };
+
+    Vector<String> patterns_;
+    Vector<int32_t> states_;
+    uint16_t classes_[256]; // Byte classes
+    uint8_t startBytes_[256]; // Non-zero for bytes that start at least one of the patterns
+    int startByte_; // The only byte that starts the patterns, or -1
+    unsigned classCount_;
+    bool compiled_;
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::PatternMatch;
+using ::spark::PatternSet;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_PATTERN_SET_H
@@ -27,11 +27,15 @@
 #include <math.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <memory>
+#include <new>
 #include "spark_wiring_print.h"
 #include "spark_wiring_json.h"
 #include "spark_wiring_variant.h"
 #include "spark_wiring_string.h"
 #include "spark_wiring_error.h"
+#include "string_convert.h"
 
 using namespace particle;
 
@@ -170,44 +174,38 @@ size_t Print::println(const __FlashStringHelper* str)
 // Private Methods /////////////////////////////////////////////////////////////
 
 size_t Print::printNumber(unsigned long n, uint8_t base) {
-  char buf[8 * sizeof(n) + 1]; // Assumes 8-bit chars plus zero byte.
-  char *str = &buf[sizeof(buf) - 1];
-
-  *str = '\0';
-
-  // prevent crash if called with base == 1
-  if (base < 2) base = 10;
-
-  do {
-   decltype(n) m = n;
-   n /= base;
-   char c = m - base * n;
-   *--str = c < 10 ? c + '0' : c + 'A' - 10;
-  } while(n);
-
-  return write(str);
+  return printNumber((unsigned long long)n, base);
 }
- 
- size_t Print::printNumber(unsigned long long n, uint8_t base) {
-  char buf[8 * sizeof(n) + 1]; // Assumes 8-bit chars plus zero byte.
 
-  char *str = &buf[sizeof(buf) - 1];
-
-  *str = '\0';
-
-  // prevent crash if called with base == 1
-  if (base < 2) base = 10;
+size_t Print::printNumber(unsigned long long n, uint8_t base) {
+  char buf[particle::detail::MAX_INTEGER_STRING_LENGTH + 1];
+  return write((const uint8_t*)buf, particle::detail::formatUnsigned(n, buf, base, true /* upperCase */));
+}
 
-  do {
-    decltype(n) m = n;
-    n /= base;
-    char c = m - base * n;
-    *--str = c < 10 ? c + '0' : c + 'A' - 10;
-  } while(n);
+#ifndef PARTICLE_WIRING_PRINT_NO_FLOAT
 
-  return write(str);
+size_t Print::printFloat(double number, uint8_t digits) {
+  if (std::isnan(number)) {
+    return print("nan");
+  }
+  if (std::isinf(number)) {
+    return print("inf");
+  }
+  char buf[32];
+  const size_t n = particle::detail::formatDouble(number, digits, buf, sizeof(buf));
+  if (n < sizeof(buf)) {
+    return write((const uint8_t*)buf, n);
+  }
+  std::unique_ptr<char[]> bigger(new(std::nothrow) char[n + 1]);
+  if (!bigger) {
+    return 0;
+  }
+  particle::detail::formatDouble(number, digits, bigger.get(), n + 1);
+  return write((const uint8_t*)bigger.get(), n);
 }
 
+#endif // PARTICLE_WIRING_PRINT_NO_FLOAT
+
 size_t Print::printVariant(const Variant& var) {
     JSONStreamWriter writer(*this);
     writeVariant(var, writer);
@@ -220,17 +218,25 @@ size_t Print::vprintf(bool newline, const char* format, va_list args)
     char test[bufsize];
     va_list args2;
     va_copy(args2, args);
-    size_t n = vsnprintf(test, bufsize, format, args);
+    const int len = vsnprintf(test, bufsize, format, args);
+    size_t n = 0;
 
-    if (n<bufsize)
+    if (len < 0)
     {
-        n = print(test);
+        // Formatting error
+    }
+    else if (len < bufsize)
+    {
+        n = write((const uint8_t*)test, len);
     }
     else
     {
-        char bigger[n+1];
-        n = vsnprintf(bigger, n+1, format, args2);
-        n = print(bigger);
+        std::unique_ptr<char[]> bigger(new(std::nothrow) char[len + 1]);
+        if (bigger)
+        {
+            vsnprintf(bigger.get(), len + 1, format, args2);
+            n = write((const uint8_t*)bigger.get(), len);
+        }
     }
     if (newline)
         n += println();
@@ -245,13 +251,65 @@ size_t OutputStringStream::write(const uint8_t* data, size_t size) {
     if (getWriteError()) {
         return 0;
     }
-    size_t newSize = s_.length() + size;
-    if (s_.capacity() < newSize && !s_.reserve(std::max<size_t>({ newSize, s_.capacity() * 3 / 2, 20 }))) {
+    if (!size) {
+        return 0;
+    }
+    // String grows its buffer geometrically
+    if (!s_.concat((const char*)data, size)) {
         setWriteError(Error::NO_MEMORY);
         return 0;
     }
-    s_.concat((const char*)data, size);
     return size;
 }
 
+BufferedPrint::BufferedPrint(Print& out, size_t bufferSize, bool flushOnNewline) :
+        out_(out),
+        buf_(bufferSize ? (uint8_t*)malloc(bufferSize) : nullptr),
+        size_(buf_ ? bufferSize : 0),
+        pos_(0),
+        flushOnNewline_(flushOnNewline) {
+}
+
+BufferedPrint::~BufferedPrint() {
+    flush();
+    free(buf_);
+}
+
+size_t BufferedPrint::write(const uint8_t* data, size_t size) {
+    if (!size) {
+        return 0;
+    }
+    if (size > size_ - pos_) {
+        if (!flush()) {
+            return 0;
+        }
+        if (size >= size_) {
+            // Pass large writes through
+            const size_t n = out_.write(data, size);
+            if (n != size) {
+                setWriteError(Error::IO);
+            }
+            return n;
+        }
+    }
+    memcpy(buf_ + pos_, data, size);
+    pos_ += size;
+    if (flushOnNewline_ && memchr(data, '\n', size) && !flush()) {
+        return 0;
+    }
+    return size;
+}
+
+bool BufferedPrint::flush() {
+    if (pos_ > 0) {
+        const size_t size = pos_;
+        pos_ = 0;
+        if (out_.write(buf_, size) != size) {
+            setWriteError(Error::IO);
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace particle
@@ -71,56 +71,7 @@ class Print
 
     static constexpr auto FLOAT_DEFAULT_FRACTIONAL_DIGITS = 2;
 
-    size_t printFloat(double number, uint8_t digits) {
-        size_t n = 0;
-
-        if (std::isnan(number)) {
-            return print("nan");
-        }
-        if (std::isinf(number)) {
-            return print("inf");
-        }
-        if (number > 4294967040.0) {
-            return print ("ovf"); // constant determined empirically
-        }
-        if (number <-4294967040.0) {
-            return print ("ovf"); // constant determined empirically
-        }
-
-        // Handle negative numbers
-        if (number < 0.0) {
-            n += print('-');
-            number = -number;
-        }
-
-        // Round correctly so that print(1.999, 2) prints as "2.00"
-        double rounding = 0.5;
-        for (uint8_t i = 0; i < digits; ++i) {
-            rounding /= 10.0;
-        }
-
-        number += rounding;
-
-        // Extract the integer part of the number and print it
-        unsigned long int_part = (unsigned long)number;
-        double remainder = number - (double)int_part;
-        n += print(int_part);
-
-        // Print the decimal point, but only if there are digits beyond
-        if (digits > 0) {
-            n += print(".");
-        }
-
-        // Extract digits from the remainder one at a time
-        while (digits-- > 0) {
-            remainder *= 10.0;
-            int toPrint = int(remainder);
-            n += print(toPrint);
-            remainder -= toPrint;
-        }
-
-        return n;
-    }
+    size_t printFloat(double number, uint8_t digits);
 #endif // PARTICLE_WIRING_PRINT_NO_FLOAT
 
     size_t printVariant(const particle::Variant& var);
@@ -239,6 +190,86 @@ private:
     String& s_;
 };
 
+/**
+ * A `Print` adapter that writes data to another `Print` in blocks.
+ *
+ * Written data is accumulated in a buffer of the specified size, and the buffer is flushed to the
+ * underlying stream when it becomes full, when `flush()` is called, when the adapter is destroyed
+ * and, optionally, when a newline character is written. Writes that are larger than the buffer
+ * are passed through to the underlying stream as is.
+ *
+ * If the buffer cannot be allocated, all writes are passed through to the underlying stream. If
+ * the underlying stream fails to accept the data, the write error is set to `Error::IO`.
+ *
+ * Example usage:
+ * ```
+ * BufferedPrint out(Serial, 256, true);
+ * out.printlnf("count: %d", count);
+ * ```
+ */
+class BufferedPrint: public Print {
+public:
+    /**
+     * Default buffer size.
+     */
+    static const size_t DEFAULT_BUFFER_SIZE = 128;
+
+    /**
+     * Constructor.
+     *
+     * @param out Underlying stream.
+     * @param bufferSize Buffer size.
+     * @param flushOnNewline Whether to flush the buffer when a newline character is written.
+     */
+    explicit BufferedPrint(Print& out, size_t bufferSize = DEFAULT_BUFFER_SIZE, bool flushOnNewline = false);
+
+    /**
+     * Destructor.
+     *
+     * Flushes the buffer.
+     */
+    ~BufferedPrint();
+
+    size_t write(uint8_t b) override {
+        if (pos_ < size_ && !(b == '\n' && flushOnNewline_)) {
+            buf_[pos_++] = b;
+            return 1;
+        }
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override;
+
+    using Print::write;
+
+    /**
+     * Write the buffered data to the underlying stream.
+     *
+     * @return `true` on success, or `false` if the underlying stream failed to accept the data.
+     */
+    bool flush();
+
+    /**
+     * Get the number of buffered bytes.
+     *
+     * @return Number of bytes.
+     */
+    size_t buffered() const {
+        return pos_;
+    }
+
+    // This class is non-copyable
+    BufferedPrint(const BufferedPrint&) = delete;
+    BufferedPrint& operator=(const BufferedPrint&) = delete;
+
+private:
+    Print& out_;
+    uint8_t* buf_;
+    size_t size_;
+    size_t pos_;
+    bool flushOnNewline_;
+};
+
 } // namespace particle
 
 template <typename T, std::enable_if_t<!std::is_base_of<Printable, T>::value && (std::is_integral<T>::value || std::is_convertible<T, unsigned long long>::value ||
@@ -258,7 +289,7 @@ inline size_t Print::print(T n, int base)
 #endif // __GNUC__ >= 9
         if (n < 0 && base == 10) {
             t = print('-');
-            val = -n;
+            val = PrintNumberType(0) - (PrintNumberType)n; // also valid for the minimum value of T
         } else {
             val = n;
         }
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_serial_pair.h"
+#include "spark_wiring_error.h"
+
+#include <thread>
+
+extern uint32_t millis();
+
+namespace spark {
+
+using particle::Error;
+
+namespace {
+
+// Maximum time in nanoseconds a port sleeps before checking the state of the link again
+const uint64_t POLL_INTERVAL = 1000000;
+
+} // namespace
+
+// Single-producer, single-consumer queue of the bytes in transit in one direction
+struct SerialPair::Port::Ring {
+    struct Entry {
+        uint64_t time; // Time at which the byte can be read
+        uint8_t data;
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    size_t mask;
+    std::atomic<size_t> head; // Modified by the writing port
+    std::atomic<size_t> tail; // Modified by the reading port
+    size_t ready; // Index of the first entry that is not known to be ready. Used by the reading port
+
+    explicit Ring(size_t capacity) :
+            entries(new Entry[capacity]),
+            mask(capacity - 1),
+            head(0),
+            tail(0),
+            ready(0) {
+    }
+};
+
+SerialPair::Port::Port() :
+        link_(nullptr),
+        rx_(nullptr),
+        lineFreeAt_(0),
+        rand_(1),
+        dropped_(0),
+        corrupted_(0) {
+}
+
+SerialPair::Port::~Port() {
+}
+
+void SerialPair::Port::init(SerialPair* link, size_t capacity, uint32_t seed) {
+    link_ = link;
+    tx_.reset(new Ring(capacity));
+    rand_ = seed ? seed : 1;
+}
+
+int SerialPair::Port::available() {
+    return readyCount();
+}
+
+int SerialPair::Port::read() {
+    if (!readyCount()) {
+        return -1;
+    }
+    const size_t tail = rx_->tail.load(std::memory_order_relaxed);
+    const uint8_t b = rx_->entries[tail & rx_->mask].data;
+    rx_->tail.store(tail + 1, std::memory_order_release);
+    return b;
+}
+
+int SerialPair::Port::peek() {
+    if (!readyCount()) {
+        return -1;
+    }
+    const size_t tail = rx_->tail.load(std::memory_order_relaxed);
+    return rx_->entries[tail & rx_->mask].data;
+}
+
+void SerialPair::Port::flush() {
+    if (link_->conf_.timeMode == TimeMode::AUTO) {
+        link_->advanceTo(lineFreeAt_);
+        return;
+    }
+    const system_tick_t start = millis();
+    while (link_->now() < lineFreeAt_) {
+        const system_tick_t elapsed = millis() - start;
+        if (elapsed >= _timeout) {
+            break;
+        }
+        link_->sleepUntil(lineFreeAt_, _timeout - elapsed);
+    }
+}
+
+size_t SerialPair::Port::write(uint8_t b) {
+    return write(&b, 1);
+}
+
+size_t SerialPair::Port::write(const uint8_t* data, size_t size) {
+    const Config& conf = link_->conf_;
+    const size_t capacity = tx_->mask + 1;
+    const system_tick_t start = millis();
+    size_t head = tx_->head.load(std::memory_order_relaxed);
+    size_t space = 0;
+    size_t n = 0;
+    while (n < size) {
+        if (!space) {
+            tx_->head.store(head, std::memory_order_release);
+            space = capacity - (head - tx_->tail.load(std::memory_order_acquire));
+            if (!space) {
+                if (!waitWritable(start)) {
+                    setWriteError(Error::TIMEOUT);
+                    break;
+                }
+                continue;
+            }
+        }
+        uint8_t b = data[n++];
+        // A byte that is lost in transit still occupies the line
+        const uint64_t now = link_->now();
+        lineFreeAt_ = ((lineFreeAt_ > now) ? lineFreeAt_ : now) + link_->byteTime_;
+        if (conf.dropRate > 0 && random() < conf.dropRate) {
+            ++dropped_;
+            continue;
+        }
+        if (conf.corruptRate > 0 && random() < conf.corruptRate) {
+            b ^= 1 << (rand_ & 7);
+            ++corrupted_;
+        }
+        Ring::Entry& e = tx_->entries[head & tx_->mask];
+        e.time = lineFreeAt_ + (uint64_t)conf.latency * 1000;
+        e.data = b;
+        ++head;
+        --space;
+    }
+    tx_->head.store(head, std::memory_order_release);
+    return n;
+}
+
+size_t SerialPair::Port::readAvailable(uint8_t* buffer, size_t length) {
+    size_t n = readyCount();
+    if (n > length) {
+        n = length;
+    }
+    const size_t tail = rx_->tail.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < n; ++i) {
+        buffer[i] = rx_->entries[(tail + i) & rx_->mask].data;
+    }
+    rx_->tail.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+int SerialPair::Port::availableForWrite() {
+    return tx_->mask + 1 - (tx_->head.load(std::memory_order_relaxed) - tx_->tail.load(std::memory_order_acquire));
+}
+
+bool SerialPair::Port::waitAvailable(system_tick_t timeout) {
+    if (readyCount()) {
+        return true;
+    }
+    if (link_->conf_.timeMode == TimeMode::AUTO) {
+        // No data is in transit, so none can arrive before the timeout expires
+        link_->advance((uint64_t)timeout * 1000);
+        return false;
+    }
+    uint64_t next = UINT64_MAX;
+    const size_t tail = rx_->tail.load(std::memory_order_relaxed);
+    if (tail != rx_->head.load(std::memory_order_acquire)) {
+        next = rx_->entries[tail & rx_->mask].time;
+    }
+    // The caller checks if the timeout has expired
+    link_->sleepUntil(next, timeout);
+    return true;
+}
+
+double SerialPair::Port::random() {
+    // xorshift32
+    rand_ ^= rand_ << 13;
+    rand_ ^= rand_ >> 17;
+    rand_ ^= rand_ << 5;
+    return (rand_ >> 8) * (1.0 / (1 << 24));
+}
+
+size_t SerialPair::Port::readyCount() {
+    size_t n = readyCount(link_->now());
+    if (!n && link_->conf_.timeMode == TimeMode::AUTO) {
+        // Skip to the time at which the next byte in transit arrives
+        const size_t tail = rx_->tail.load(std::memory_order_relaxed);
+        if (tail != rx_->head.load(std::memory_order_acquire)) {
+            link_->advanceTo(rx_->entries[tail & rx_->mask].time);
+            n = readyCount(link_->now());
+        }
+    }
+    return n;
+}
+
+size_t SerialPair::Port::readyCount(uint64_t now) {
+    // Arrival times are monotonic, so the entries before rx_->ready don't need to be checked again
+    const size_t head = rx_->head.load(std::memory_order_acquire);
+    const size_t tail = rx_->tail.load(std::memory_order_relaxed);
+    size_t r = rx_->ready;
+    while (r != head && rx_->entries[r & rx_->mask].time <= now) {
+        ++r;
+    }
+    rx_->ready = r;
+    return r - tail;
+}
+
+bool SerialPair::Port::waitWritable(system_tick_t start) {
+    if (link_->conf_.timeMode == TimeMode::AUTO) {
+        // The data can't be read while this port is being written to
+        return false;
+    }
+    const system_tick_t elapsed = millis() - start;
+    if (elapsed >= _timeout) {
+        return false;
+    }
+    link_->sleepUntil(UINT64_MAX, _timeout - elapsed);
+    return true;
+}
+
+SerialPair::SerialPair() :
+        SerialPair(Config()) {
+}
+
+SerialPair::SerialPair(const Config& conf) :
+        conf_(conf),
+        start_(std::chrono::steady_clock::now()),
+        offset_(0),
+        byteTime_(conf.baudRate ? (uint64_t)conf.bitsPerByte * 1000000000 / conf.baudRate : 0) {
+    size_t capacity = 1;
+    while (capacity < conf_.bufferSize) {
+        capacity <<= 1;
+    }
+    port1_.init(this, capacity, conf_.seed);
+    port2_.init(this, capacity, conf_.seed ^ 0x9e3779b9);
+    port1_.rx_ = port2_.tx_.get();
+    port2_.rx_ = port1_.tx_.get();
+}
+
+SerialPair::~SerialPair() {
+}
+
+uint64_t SerialPair::now() const {
+    const uint64_t offs = offset_.load(std::memory_order_relaxed);
+    if (conf_.timeMode != TimeMode::SCALED) {
+        return offs;
+    }
+    const auto d = std::chrono::steady_clock::now() - start_;
+    return (uint64_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() * conf_.timeScale) + offs;
+}
+
+void SerialPair::advanceTo(uint64_t time) {
+    // Only used in the AUTO mode where the offset is the current time
+    uint64_t t = offset_.load(std::memory_order_relaxed);
+    while (t < time && !offset_.compare_exchange_weak(t, time, std::memory_order_relaxed)) {
+    }
+}
+
+void SerialPair::sleepUntil(uint64_t time, system_tick_t timeout) const {
+    uint64_t ns = POLL_INTERVAL;
+    if (conf_.timeMode == TimeMode::SCALED && time != UINT64_MAX) {
+        const uint64_t t = now();
+        const uint64_t d = (time > t) ? (uint64_t)((time - t) / conf_.timeScale) : 0;
+        if (d < ns) {
+            ns = d;
+        }
+    }
+    if ((uint64_t)timeout * 1000000 < ns) {
+        ns = (uint64_t)timeout * 1000000;
+    }
+    if (ns) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace spark
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_SERIAL_PAIR_H
+#define SPARK_WIRING_SERIAL_PAIR_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "spark_wiring_stream.h"
+
+namespace spark {
+
+/**
+ * A simulated serial link between two streams.
+ *
+ * Data written to one port of the pair can be read from the other port after the time it takes
+ * to transmit it at the configured baud rate, plus the configured latency. Each direction of the
+ * link is backed by a lock-free single-producer, single-consumer ring buffer, so each port can
+ * be used by a different thread. Bytes can optionally be dropped or corrupted at random to test
+ * error handling.
+ *
+ * The link uses its own simulated clock, which runs in one of the following modes:
+ *
+ * - `TimeMode::AUTO`: the clock jumps to the arrival time of the next byte in transit whenever a
+ *   port has no data ready to be read, and waiting for data that is not in transit returns
+ *   immediately. This mode is intended for tests that use both ports from a single thread, and
+ *   transfers take as little wall time as possible regardless of the baud rate.
+ * - `TimeMode::SCALED`: the clock runs `timeScale` times faster than the real time. Stream
+ *   timeouts are still measured in real time.
+ * - `TimeMode::MANUAL`: the clock only advances when `advance()` is called.
+ *
+ * Writing to a port blocks while its transmit buffer is full. In the `AUTO` mode, or if the stream
+ * timeout expires, the remaining data is discarded and the write error is set to `Error::TIMEOUT`.
+ *
+ * Example usage:
+ * ```
+ * SerialPair::Config conf;
+ * conf.baudRate = 9600;
+ * SerialPair link(conf);
+ * link.port1().println("AT");
+ * String resp = link.port2().readStringUntil('\n');
+ * uint64_t elapsed = link.micros(); // Simulated time it took to transmit the command
+ * ```
+ */
+class SerialPair {
+public:
+    /**
+     * Clock mode.
+     */
+    enum class TimeMode {
+        AUTO, ///< The clock jumps to the next event when a port has no data to read.
+        SCALED, ///< The clock runs at a multiple of the real time.
+        MANUAL ///< The clock only advances when `advance()` is called.
+    };
+
+    /**
+     * Link settings.
+     */
+    struct Config {
+        unsigned baudRate = 9600; ///< Baud rate, or 0 to transmit data instantly.
+        unsigned bitsPerByte = 10; ///< Number of bits transmitted per byte, including start, stop and parity bits.
+        unsigned latency = 0; ///< Additional delay in microseconds before a transmitted byte can be read.
+        double dropRate = 0; ///< Probability that a byte is lost in transit.
+        double corruptRate = 0; ///< Probability that a bit of a byte is flipped in transit.
+        uint32_t seed = 1; ///< Seed of the random number generator used for fault injection.
+        size_t bufferSize = 4096; ///< Size of the transmit buffer of each port. Rounded up to a power of two.
+        TimeMode timeMode = TimeMode::AUTO; ///< Clock mode.
+        double timeScale = 1; ///< Clock rate in the `SCALED` mode.
+    };
+
+    /**
+     * One end of the link.
+     */
+    class Port: public Stream {
+    public:
+        int available() override;
+        int read() override;
+        int peek() override;
+        void flush() override;
+        size_t write(uint8_t b) override;
+        size_t write(const uint8_t* data, size_t size) override;
+        size_t readAvailable(uint8_t* buffer, size_t length) override;
+
+        using Print::write;
+
+        /**
+         * Get the number of bytes that can be written without blocking.
+         *
+         * @return Number of bytes.
+         */
+        int availableForWrite();
+
+        /**
+         * Get the number of bytes written to this port that were dropped in transit.
+         *
+         * @return Number of bytes.
+         */
+        size_t droppedBytes() const {
+            return dropped_;
+        }
+
+        /**
+         * Get the number of bytes written to this port that were corrupted in transit.
+         *
+         * @return Number of bytes.
+         */
+        size_t corruptedBytes() const {
+            return corrupted_;
+        }
+
+        // This class is non-copyable
+        Port(const Port&) = delete;
+        Port& operator=(const Port&) = delete;
+
+    protected:
+        bool waitAvailable(system_tick_t timeout) override;
+
+    private:
+        struct Ring;
+
+        SerialPair* link_;
+        std::unique_ptr<Ring> tx_;
+        Ring* rx_;
+        uint64_t lineFreeAt_; // Time at which the last transmitted byte leaves the line
+        uint32_t rand_;
+        size_t dropped_;
+        size_t corrupted_;
+
+        Port();
+        ~Port();
+
+        void init(SerialPair* link, size_t capacity, uint32_t seed);
+        double random();
+        size_t readyCount();
+        size_t readyCount(uint64_t now);
+        bool waitWritable(system_tick_t start);
+
+        friend class SerialPair;
+    };
+
+    /**
+     * Constructor.
+     *
+     * Creates a link with the default settings.
+     */
+    SerialPair();
+
+    /**
+     * Constructor.
+     *
+     * @param conf Link settings.
+     */
+    explicit SerialPair(const Config& conf);
+
+    /**
+     * Destructor.
+     */
+    ~SerialPair();
+
+    /**
+     * Get the first port.
+     *
+     * @return Port.
+     */
+    Port& port1() {
+        return port1_;
+    }
+
+    /**
+     * Get the second port.
+     *
+     * @return Port.
+     */
+    Port& port2() {
+        return port2_;
+    }
+
+    /**
+     * Get the current time of the simulated clock.
+     *
+     * @return Time in microseconds.
+     */
+    uint64_t micros() const {
+        return now() / 1000;
+    }
+
+    /**
+     * Advance the simulated clock.
+     *
+     * @param us Number of microseconds.
+     */
+    void advance(uint64_t us) {
+        offset_.fetch_add(us * 1000, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the link settings.
+     *
+     * @return Settings.
+     */
+    const Config& config() const {
+        return conf_;
+    }
+
+    // This class is non-copyable
+    SerialPair(const SerialPair&) = delete;
+    SerialPair& operator=(const SerialPair&) = delete;
+
+private:
+    Config conf_;
+    Port port1_;
+    Port port2_;
+    std::chrono::steady_clock::time_point start_;
+    std::atomic<uint64_t> offset_; // Time in nanoseconds that is not accounted for by the real time
+    uint64_t byteTime_; // Time in nanoseconds it takes to transmit one byte
+
+    uint64_t now() const;
+    void advanceTo(uint64_t time);
+    void sleepUntil(uint64_t time, system_tick_t timeout) const;
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::SerialPair;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_SERIAL_PAIR_H
@@ -0,0 +1,651 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_SMALL_VECTOR_H
+#define SPARK_WIRING_SMALL_VECTOR_H
+
+#include "spark_wiring_vector.h"
+
+namespace spark {
+
+/**
+ * A dynamic array that stores up to `N` elements in the object itself.
+ *
+ * `SmallVector` provides the same interface as `Vector`. Memory is allocated via `AllocatorT` only
+ * when the number of elements exceeds `N`. If the array shrinks back to `N` elements or less,
+ * `trimToSize()` moves the elements back to the inline storage.
+ *
+ * @tparam T Element type.
+ * @tparam N Number of elements that can be stored without allocating memory.
+ * @tparam AllocatorT Allocator type.
+ */
+template<typename T, int N, typename AllocatorT = DefaultAllocator>
+class SmallVector: private detail::VectorElements<T> {
+public:
+    static_assert(N > 0, "Inline capacity must be greater than 0");
+
+    typedef T ValueType;
+    typedef AllocatorT AllocatorType;
+    typedef T* Iterator;
+    typedef const T* ConstIterator;
+
+    static const int INLINE_CAPACITY = N;
+
+    SmallVector();
+    explicit SmallVector(int n);
+    SmallVector(int n, const T& value);
+    SmallVector(const T* values, int n);
+    SmallVector(std::initializer_list<T> values);
+    SmallVector(const SmallVector<T, N, AllocatorT>& vector);
+    SmallVector(SmallVector<T, N, AllocatorT>&& vector);
+    ~SmallVector();
+
+    bool append(T value);
+    bool append(int n, const T& value);
+    bool append(const T* values, int n);
+    bool append(const SmallVector<T, N, AllocatorT>& vector);
+
+    bool prepend(T value);
+    bool prepend(int n, const T& value);
+    bool prepend(const T* values, int n);
+    bool prepend(const SmallVector<T, N, AllocatorT>& vector);
+
+    bool insert(int i, T value);
+    bool insert(int i, int n, const T& value);
+    bool insert(int i, const T* values, int n);
+    bool insert(int i, const SmallVector<T, N, AllocatorT>& vector);
+
+    void removeAt(int i, int n = 1);
+    bool removeOne(const T& value);
+    int removeAll(const T& value);
+
+    T takeFirst();
+    T takeLast();
+    T takeAt(int i);
+
+    T& first();
+    const T& first() const;
+    T& last();
+    const T& last() const;
+    T& at(int i);
+    const T& at(int i) const;
+
+    SmallVector<T, N, AllocatorT> copy(int i, int n) const;
+
+    int indexOf(const T& value, int i = 0) const;
+    int lastIndexOf(const T& value) const;
+    int lastIndexOf(const T& value, int i) const;
+
+    bool contains(const T& value) const;
+
+    SmallVector<T, N, AllocatorT>& fill(const T& value);
+
+    bool resize(int n);
+    int size() const;
+    bool isEmpty() const;
+
+    bool reserve(int n);
+    int capacity() const;
+    bool trimToSize();
+
+    // Returns true if the elements are stored in the object itself
+    bool isInline() const;
+
+    void clear();
+
+    T* data();
+    const T* data() const;
+
+    Iterator begin();
+    ConstIterator begin() const;
+    Iterator end();
+    ConstIterator end() const;
+
+    Iterator insert(ConstIterator pos, T value);
+    Iterator erase(ConstIterator pos);
+
+    T& operator[](int i);
+    const T& operator[](int i) const;
+
+    bool operator==(const SmallVector<T, N, AllocatorT> &vector) const;
+    bool operator!=(const SmallVector<T, N, AllocatorT> &vector) const;
+
+    SmallVector<T, N, AllocatorT>& operator=(SmallVector<T, N, AllocatorT> vector);
+
+private:
+    T* data_;
+    int size_, capacity_;
+    alignas(T) char buf_[N * sizeof(T)];
+
+    using detail::VectorElements<T>::copy;
+    using detail::VectorElements<T>::move;
+    using detail::VectorElements<T>::find;
+    using detail::VectorElements<T>::rfind;
+    using detail::VectorElements<T>::construct;
+    using detail::VectorElements<T>::destruct;
+
+    T* inlineData() {
+        return reinterpret_cast<T*>(buf_);
+    }
+
+    bool grow(int n) {
+        if (n <= capacity_) {
+            return true;
+        }
+        return realloc(detail::VectorGrowthPolicy<AllocatorT>::capacity(capacity_, n));
+    }
+
+    bool realloc(int n) {
+        if (n < size_) {
+            n = size_;
+        }
+        T* d = nullptr;
+        if (n <= N) {
+            if (isInline()) {
+                return true;
+            }
+            d = inlineData();
+            n = N;
+        } else if (!isInline() && IsTriviallyRelocatable<T>::value) {
+            d = (T*)AllocatorT::realloc(data_, n * sizeof(T));
+            if (!d) {
+                return false;
+            }
+            data_ = d;
+            capacity_ = n;
+            return true;
+        } else {
+            d = (T*)AllocatorT::malloc(n * sizeof(T));
+            if (!d) {
+                return false;
+            }
+        }
+        move(d, data_, data_ + size_);
+        if (!isInline()) {
+            AllocatorT::free(data_);
+        }
+        data_ = d;
+        capacity_ = n;
+        return true;
+    }
+
+    // Takes the elements of another array. This array must be inline and empty. The other array
+    // is left inline and empty
+    void take(SmallVector<T, N, AllocatorT>& vector) {
+        if (vector.isInline()) {
+            move(data_, vector.data_, vector.data_ + vector.size_);
+        } else {
+            data_ = vector.data_;
+            capacity_ = vector.capacity_;
+            vector.data_ = vector.inlineData();
+            vector.capacity_ = N;
+        }
+        size_ = vector.size_;
+        vector.size_ = 0;
+    }
+
+    template<typename V, int M, typename A>
+    friend void swap(SmallVector<V, M, A>& vector, SmallVector<V, M, A>& vector2);
+};
+
+template<typename T, int N, typename AllocatorT>
+void swap(SmallVector<T, N, AllocatorT>& vector, SmallVector<T, N, AllocatorT>& vector2);
+
+} // spark
+
+namespace particle {
+
+using ::spark::SmallVector;
+
+} // particle
+
+// spark::SmallVector
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector() :
+        data_(inlineData()),
+        size_(0),
+        capacity_(N) {
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector(int n) : SmallVector() {
+    if (n > 0 && reserve(n)) {
+        construct(data_, data_ + n);
+        size_ = n;
+    }
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector(int n, const T& value) : SmallVector() {
+    if (n > 0 && reserve(n)) {
+        construct(data_, data_ + n, value);
+        size_ = n;
+    }
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector(const T* values, int n) : SmallVector() {
+    if (n > 0 && reserve(n)) {
+        copy(data_, values, values + n);
+        size_ = n;
+    }
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector(std::initializer_list<T> values) : SmallVector() {
+    const int n = values.size();
+    if (n > 0 && reserve(n)) {
+        copy(data_, values.begin(), values.end());
+        size_ = n;
+    }
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector(const SmallVector<T, N, AllocatorT>& vector) : SmallVector() {
+    if (vector.size_ > 0 && reserve(vector.size_)) {
+        copy(data_, vector.data_, vector.data_ + vector.size_);
+        size_ = vector.size_;
+    }
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::SmallVector(SmallVector<T, N, AllocatorT>&& vector) : SmallVector() {
+    take(vector);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>::~SmallVector() {
+    destruct(data_, data_ + size_);
+    if (!isInline()) {
+        AllocatorT::free(data_);
+    }
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::append(T value) {
+    return insert(size_, std::move(value));
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::append(int n, const T& value) {
+    return insert(size_, n, value);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::append(const T* values, int n) {
+    return insert(size_, values, n);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::append(const SmallVector<T, N, AllocatorT> &vector) {
+    return insert(size_, vector);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::prepend(T value) {
+    return insert(0, std::move(value));
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::prepend(int n, const T& value) {
+    return insert(0, n, value);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::prepend(const T* values, int n) {
+    return insert(0, values, n);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::prepend(const SmallVector<T, N, AllocatorT> &vector) {
+    return insert(0, vector);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::insert(int i, T value) {
+    if (!grow(size_ + 1)) {
+        return false;
+    }
+    T* const p = data_ + i;
+    move(p + 1, p, data_ + size_);
+    new(p) T(std::move(value));
+    ++size_;
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::insert(int i, int n, const T& value) {
+    if (!grow(size_ + n)) {
+        return false;
+    }
+    T* const p = data_ + i;
+    move(p + n, p, data_ + size_);
+    construct(p, p + n, value);
+    size_ += n;
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::insert(int i, const T* values, int n) {
+    if (!grow(size_ + n)) {
+        return false;
+    }
+    T* const p = data_ + i;
+    move(p + n, p, data_ + size_);
+    copy(p, values, values + n);
+    size_ += n;
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::insert(int i, const SmallVector<T, N, AllocatorT> &vector) {
+    return insert(i, vector.data_, vector.size_);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline void spark::SmallVector<T, N, AllocatorT>::removeAt(int i, int n) {
+    if (n < 0 || i + n > size_) {
+        n = size_ - i;
+    }
+    T* const p = data_ + i;
+    destruct(p, p + n);
+    move(p, p + n, data_ + size_);
+    size_ -= n;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::removeOne(const T &value) {
+    T* const p = find(data_, data_ + size_, value);
+    if (!p) {
+        return false;
+    }
+    p->~T();
+    move(p, p + 1, data_ + size_);
+    --size_;
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline int spark::SmallVector<T, N, AllocatorT>::removeAll(const T &value) {
+    T* p = data_;
+    T* end = p + size_;
+    while ((p = find(p, end, value))) {
+        p->~T();
+        move(p, p + 1, end);
+        --end;
+    }
+    const int n = size_ - (end - data_);
+    size_ -= n;
+    return n;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T spark::SmallVector<T, N, AllocatorT>::takeFirst() {
+    return takeAt(0);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T spark::SmallVector<T, N, AllocatorT>::takeLast() {
+    return takeAt(size_ - 1);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T spark::SmallVector<T, N, AllocatorT>::takeAt(int i) {
+    T* const p = data_ + i;
+    T v(std::move(*p));
+    p->~T();
+    move(p, p + 1, data_ + size_);
+    --size_;
+    return v;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T& spark::SmallVector<T, N, AllocatorT>::first() {
+    return data_[0];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline const T& spark::SmallVector<T, N, AllocatorT>::first() const {
+    return data_[0];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T& spark::SmallVector<T, N, AllocatorT>::last() {
+    return data_[size_ - 1];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline const T& spark::SmallVector<T, N, AllocatorT>::last() const {
+    return data_[size_ - 1];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T& spark::SmallVector<T, N, AllocatorT>::at(int i) {
+    return data_[i];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline const T& spark::SmallVector<T, N, AllocatorT>::at(int i) const {
+    return data_[i];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT> spark::SmallVector<T, N, AllocatorT>::copy(int i, int n) const {
+    if (n < 0 || i + n > size_) {
+        n = size_ - i;
+    }
+    SmallVector<T, N, AllocatorT> v;
+    if (n > 0 && v.reserve(n)) {
+        const T* const p = data_ + i;
+        copy(v.data_, p, p + n);
+        v.size_ = n;
+    }
+    return v;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline int spark::SmallVector<T, N, AllocatorT>::indexOf(const T &value, int i) const {
+    const T* const p = find(data_ + i, data_ + size_, value);
+    if (!p) {
+        return -1;
+    }
+    return p - data_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline int spark::SmallVector<T, N, AllocatorT>::lastIndexOf(const T &value) const {
+    return lastIndexOf(value, size_ - 1);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline int spark::SmallVector<T, N, AllocatorT>::lastIndexOf(const T &value, int i) const {
+    const T* const p = rfind(data_ + i, data_ - 1, value);
+    if (!p) {
+        return -1;
+    }
+    return p - data_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::contains(const T &value) const {
+    return find(data_, data_ + size_, value);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>& spark::SmallVector<T, N, AllocatorT>::fill(const T& value) {
+    destruct(data_, data_ + size_);
+    construct(data_, data_ + size_, value);
+    return *this;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::resize(int n) {
+    if (n > size_) {
+        if (n > capacity_ && !realloc(n)) {
+            return false;
+        }
+        construct(data_ + size_, data_ + n);
+        size_ = n;
+    } else if (n >= 0) {
+        destruct(data_ + n, data_ + size_);
+        size_ = n;
+    }
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline int spark::SmallVector<T, N, AllocatorT>::size() const {
+    return size_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::isEmpty() const {
+    return size_ == 0;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::reserve(int n) {
+    if (n > capacity_ && !realloc(n)) {
+        return false;
+    }
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline int spark::SmallVector<T, N, AllocatorT>::capacity() const {
+    return capacity_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::trimToSize() {
+    if (capacity_ > size_ && !realloc(size_)) {
+        return false;
+    }
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::isInline() const {
+    return data_ == reinterpret_cast<const T*>(buf_);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline void spark::SmallVector<T, N, AllocatorT>::clear() {
+    destruct(data_, data_ + size_);
+    size_ = 0;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T* spark::SmallVector<T, N, AllocatorT>::data() {
+    return data_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline const T* spark::SmallVector<T, N, AllocatorT>::data() const {
+    return data_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline typename spark::SmallVector<T, N, AllocatorT>::Iterator spark::SmallVector<T, N, AllocatorT>::begin() {
+    return data_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline typename spark::SmallVector<T, N, AllocatorT>::ConstIterator spark::SmallVector<T, N, AllocatorT>::begin() const {
+    return data_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline typename spark::SmallVector<T, N, AllocatorT>::Iterator spark::SmallVector<T, N, AllocatorT>::end() {
+    return data_ + size_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline typename spark::SmallVector<T, N, AllocatorT>::ConstIterator spark::SmallVector<T, N, AllocatorT>::end() const {
+    return data_ + size_;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline typename spark::SmallVector<T, N, AllocatorT>::Iterator spark::SmallVector<T, N, AllocatorT>::insert(ConstIterator pos, T value) {
+    int i = pos - data_;
+    if (!insert(i, std::move(value))) {
+        return data_ + size_;
+    }
+    return data_ + i;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline typename spark::SmallVector<T, N, AllocatorT>::Iterator spark::SmallVector<T, N, AllocatorT>::erase(ConstIterator pos) {
+    int i = pos - data_;
+    removeAt(i);
+    return data_ + i;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline T& spark::SmallVector<T, N, AllocatorT>::operator[](int i) {
+    return data_[i];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline const T& spark::SmallVector<T, N, AllocatorT>::operator[](int i) const {
+    return data_[i];
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::operator==(const SmallVector<T, N, AllocatorT> &vector) const {
+    if (size_ != vector.size_) {
+        return false;
+    }
+    const T* p = data_;
+    const T* p2 = vector.data_;
+    const T* const end = p + size_;
+    for (; p != end; ++p, ++p2) {
+        if (*p != *p2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename T, int N, typename AllocatorT>
+inline bool spark::SmallVector<T, N, AllocatorT>::operator!=(const SmallVector<T, N, AllocatorT> &vector) const {
+    return !(*this == vector);
+}
+
+template<typename T, int N, typename AllocatorT>
+inline spark::SmallVector<T, N, AllocatorT>& spark::SmallVector<T, N, AllocatorT>::operator=(SmallVector<T, N, AllocatorT> vector) {
+    swap(*this, vector);
+    return *this;
+}
+
+// spark::
+template<typename T, int N, typename AllocatorT>
+inline void spark::swap(SmallVector<T, N, AllocatorT>& vector, SmallVector<T, N, AllocatorT>& vector2) {
+    if (!vector.isInline() && !vector2.isInline()) {
+        using std::swap;
+        swap(vector.data_, vector2.data_);
+        swap(vector.size_, vector2.size_);
+        swap(vector.capacity_, vector2.capacity_);
+        return;
+    }
+    SmallVector<T, N, AllocatorT> tmp;
+    tmp.take(vector);
+    vector.take(vector2);
+    vector2.take(tmp);
+}
+
+#endif // SPARK_WIRING_SMALL_VECTOR_H
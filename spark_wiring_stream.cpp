@@ -40,7 +40,7 @@ int Stream::timedRead()
   do {
     c = read();
     if (c >= 0) return c;
-  } while(millis() - _startMillis < _timeout);
+  } while(timedWait());
   return -1;     // -1 indicates timeout
 }
 
@@ -52,10 +52,23 @@ int Stream::timedPeek()
   do {
     c = peek();
     if (c >= 0) return c;
-  } while(millis() - _startMillis < _timeout);
+  } while(timedWait());
   return -1;     // -1 indicates timeout
 }
 
+// private method to wait for data until the stream timeout expires
+bool Stream::timedWait()
+{
+  system_tick_t elapsed = millis() - _startMillis;
+  if (elapsed >= _timeout) return false;
+  return waitAvailable(_timeout - elapsed);
+}
+
+bool Stream::waitAvailable(system_tick_t timeout)
+{
+  return true;
+}
+
 // returns peek of the next digit in the stream or -1 if timeout
 // discards non-numeric characters
 int Stream::peekNextDigit()
@@ -76,6 +89,17 @@ int Stream::peekNextDigit()
 // Public Methods
 //////////////////////////////////////////////////////////////
 
+size_t Stream::readAvailable(uint8_t *buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length) {
+    int c = read();
+    if (c < 0) break;
+    buffer[count++] = (uint8_t)c;
+  }
+  return count;
+}
+
 void Stream::setTimeout(system_tick_t timeout)  // sets the maximum number of milliseconds to wait
 {
   _timeout = timeout;
@@ -230,10 +254,16 @@ size_t Stream::readBytes(char *buffer, size_t length)
 {
   size_t count = 0;
   while (count < length) {
-    int c = timedRead();
-    if (c < 0) break;
-    *buffer++ = (char)c;
-    count++;
+    // the clock is only read when the stream runs out of data
+    size_t n = readAvailable((uint8_t *)buffer + count, length - count);
+    if (n == 0) {
+      _startMillis = millis();
+      do {
+        n = readAvailable((uint8_t *)buffer + count, length - count);
+      } while (n == 0 && timedWait());
+      if (n == 0) break; // timeout
+    }
+    count += n;
   }
   return count;
 }
@@ -280,6 +310,36 @@ String Stream::readStringUntil(char terminator)
   return ret;
 }
 
+namespace particle {
+
+size_t InputBufferStream::readAvailable(uint8_t* buffer, size_t length)
+{
+  const size_t n = (length < remaining()) ? length : remaining();
+  if (n > 0) {
+    memcpy(buffer, pos_, n);
+    pos_ += n;
+  }
+  return n;
+}
+
+size_t InputBufferStream::readBytesUntil(char terminator, char* buffer, size_t length)
+{
+  size_t n = (length < remaining()) ? length : remaining();
+  const uint8_t* p = n ? (const uint8_t*)memchr(pos_, (uint8_t)terminator, n) : nullptr;
+  size_t skip = 0; // the terminator is consumed but not stored
+  if (p) {
+    n = p - pos_;
+    skip = 1;
+  }
+  if (n > 0) {
+    memcpy(buffer, pos_, n);
+  }
+  pos_ += n + skip;
+  return n;
+}
+
+} // namespace particle
+
 void serialReadLine(Stream *serialObj, char *dst, int max_len, system_tick_t timeout, void(*idle_cb)(int count))
 {
     char c = 0, i = 0;
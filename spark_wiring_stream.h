@@ -48,6 +48,10 @@ class Stream : public Print
     system_tick_t _startMillis;  // used for timeout measurement
     int timedRead();    // private method to read stream with timeout
     int timedPeek();    // private method to peek stream with timeout
+    bool timedWait();   // waits for more data; returns false if the timeout measured from _startMillis has expired
+    virtual bool waitAvailable(system_tick_t timeout); // blocks until data may be available for reading or timeout
+    // milliseconds pass. returns false if no more data can arrive. the default implementation returns
+    // immediately, in which case the timed methods poll the stream until the timeout expires
     int peekNextDigit(); // returns the next numeric digit in the stream or -1 if timeout
 
   public:
@@ -56,6 +60,10 @@ class Stream : public Print
     virtual int peek() = 0;
     virtual void flush() = 0;
 
+    virtual size_t readAvailable(uint8_t *buffer, size_t length); // reads up to length bytes without waiting for more data
+    // returns the number of bytes read (0 if no data is available). the default implementation
+    // calls read() for each byte; streams that can copy their data in bulk should override it
+
     Stream() {_timeout=1000;}
 
 // parsing methods
@@ -83,7 +91,7 @@ class Stream : public Print
   // terminates if length characters have been read or timeout (see setTimeout)
   // returns the number of characters placed in the buffer (0 means no valid data found)
 
-  size_t readBytesUntil( char terminator, char *buffer, size_t length); // as readBytes with terminator character
+  virtual size_t readBytesUntil( char terminator, char *buffer, size_t length); // as readBytes with terminator character
   // terminates if length characters have been read, timeout, or if the terminator character  detected
   // returns the number of characters placed in the buffer (0 means no valid data found)
 
@@ -99,4 +107,92 @@ class Stream : public Print
   float parseFloat(char skipChar);  // as above but the given skipChar is ignored
 };
 
+namespace particle {
+
+/**
+ * An input stream reading from a buffer in memory.
+ *
+ * The data is not copied and must remain valid while the stream is in use. Reading past the end
+ * of the buffer doesn't wait for the stream timeout to expire.
+ */
+class InputBufferStream: public Stream {
+public:
+    /**
+     * Constructor.
+     *
+     * @param data Data.
+     * @param size Data size.
+     */
+    InputBufferStream(const uint8_t* data, size_t size) :
+            pos_(data),
+            end_(data + size) {
+    }
+
+    int available() override {
+        return remaining();
+    }
+
+    int read() override {
+        return (pos_ != end_) ? *pos_++ : -1;
+    }
+
+    int peek() override {
+        return (pos_ != end_) ? *pos_ : -1;
+    }
+
+    void flush() override {
+    }
+
+    size_t write(uint8_t b) override {
+        return 0; // Not supported
+    }
+
+    using Print::write;
+
+    size_t readAvailable(uint8_t* buffer, size_t length) override;
+    size_t readBytesUntil(char terminator, char* buffer, size_t length) override;
+
+    /**
+     * Get the number of bytes left to read.
+     *
+     * @return Number of bytes.
+     */
+    size_t remaining() const {
+        return end_ - pos_;
+    }
+
+protected:
+    bool waitAvailable(system_tick_t timeout) override {
+        return false; // No more data can arrive
+    }
+
+private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+/**
+ * An input stream reading from a string.
+ *
+ * The stream reads the characters of the string in place. The string must not be modified or
+ * destroyed while the stream is in use, so the stream can't be constructed from a temporary.
+ *
+ * @see `OutputStringStream`
+ */
+class InputStringStream: public InputBufferStream {
+public:
+    /**
+     * Constructor.
+     *
+     * @param str String.
+     */
+    explicit InputStringStream(const String& str) :
+            InputBufferStream((const uint8_t*)str.c_str(), str.length()) {
+    }
+
+    InputStringStream(String&&) = delete;
+};
+
+} // namespace particle
+
 #endif
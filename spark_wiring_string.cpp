@@ -27,43 +27,26 @@
  */
 
 #include "spark_wiring_string.h"
+#include "spark_wiring_pattern_set.h"
 #include <stdio.h>
 #include <limits.h>
-#include <ctype.h>
 #include <stdlib.h>
-#include <charconv>
 #include "string_convert.h"
 
-using namespace particle;
-
-//These are very crude implementations - will refine later
-//------------------------------------------------------------------------------------------
-
-void dtoa (double val, unsigned char prec, char *sout) {
-    bool negative = val<0;
-    if (negative) {
-        val = -val;
-        *sout++ = '-';
-    }
-    long scale = 1;
-    for (uint8_t i=0; i<prec; i++)
-        scale *= 10;
-    val *= scale;   // capture all the significant digits
-    uint64_t fixed = uint64_t(val);
-    if ((val-fixed)>=0.5)    // round last digit
-        fixed++;
+#include <atomic>
+#include <new>
 
-    unsigned long first = (unsigned long)(fixed / scale);
-    unsigned long second = (unsigned long)(fixed % scale);
-
-    ultoa(first, sout, 10, 1);
-    if (prec) {
-        sout += strlen(sout);
-        *sout++ = '.';
-        ultoa(second, sout, 10, prec);
-    }
-}
+using particle::detail::compareIgnoreCaseAscii;
+using particle::detail::formatDouble;
+using particle::detail::formatInteger;
+using particle::detail::formatSigned;
+using particle::detail::formatUnsigned;
+using particle::detail::isSpaceAscii;
+using particle::detail::toLowerCaseAscii;
+using particle::detail::toUpperCaseAscii;
+using particle::detail::MAX_INTEGER_STRING_LENGTH;
 
+using namespace particle;
 
 /*********************************************/
 /*  Constructors                             */
@@ -85,6 +68,12 @@ String::String(const char *cstr, unsigned int length)
     }
 }
 
+String::String(spark::StringView str)
+{
+    init();
+    copy(str.data(), str.size());
+}
+
 String::String(const String &value)
 {
     init();
@@ -125,120 +114,279 @@ String::String(char c)
 String::String(unsigned char value, unsigned char base)
 {
     init();
-    char buf[9] = {};
-    utoa(value, buf, base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatInteger(value, buf, base));
 }
 
 String::String(int value, unsigned char base)
 {
     init();
-    char buf[34] = {};
-    itoa(value, buf, base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatInteger(value, buf, base));
 }
 
 String::String(unsigned int value, unsigned char base)
 {
     init();
-    char buf[33] = {};
-    utoa(value, buf, base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatInteger(value, buf, base));
 }
 
 String::String(long value, unsigned char base)
 {
     init();
-    char buf[34] = {};
-    ltoa(value, buf, base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatInteger(value, buf, base));
 }
 
 String::String(unsigned long value, unsigned char base)
 {
     init();
-    char buf[33] = {};
-    ultoa(value, buf, base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatInteger(value, buf, base));
 }
 
 String::String(long long value, unsigned char base)
 {
     init();
-    char buf[66] = {};  // Assuming a maximum of 64-bit binary representation + '-' + null terminator.
-    std::to_chars(buf, buf + sizeof(buf) - 1, value, (int)base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatSigned(value, buf, base));
 }
 
 String::String(unsigned long long value, unsigned char base)
 {
     init();
-    char buf[65] = {};  // Assuming a maximum of 64-bit binary representation + null terminator.
-    std::to_chars(buf, buf + sizeof(buf) - 1, value, (int)base);
-    *this = buf;
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    copy(buf, formatUnsigned(value, buf, base));
 }
 
 String::String(float value, int decimalPlaces)
 {
     init();
-    char buf[33] = {};
-    dtoa(value, decimalPlaces, buf);
-  *this = buf;
+    concat((double)value, decimalPlaces);
 }
 
 String::String(double value, int decimalPlaces)
 {
     init();
-    char buf[33] = {};
-    dtoa(value, decimalPlaces, buf);
-  *this = buf;
+    concat(value, decimalPlaces);
 }
 String::~String()
 {
-    free(buffer);
+    releaseBuffer();
 }
 
 /*********************************************/
 /*  Memory Management                        */
 /*********************************************/
 
+namespace {
+
+// Reference-counted buffers are prefixed with the number of strings using them
+struct SharedBuffer {
+    std::atomic<unsigned int> refs;
+};
+
+inline SharedBuffer *sharedBuffer(char *ptr)
+{
+    return reinterpret_cast<SharedBuffer *>(ptr - sizeof(SharedBuffer));
+}
+
+char *allocateSharedBuffer(unsigned int maxStrLen)
+{
+    void *p = malloc(sizeof(SharedBuffer) + maxStrLen + 1);
+    if (!p) {
+        return nullptr;
+    }
+    new(p) SharedBuffer{1};
+    return (char *)p + sizeof(SharedBuffer);
+}
+
+void releaseSharedBuffer(char *ptr)
+{
+    if (ptr) {
+        SharedBuffer *b = sharedBuffer(ptr);
+        if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            b->~SharedBuffer();
+            free(b);
+        }
+    }
+}
+
+} // namespace
+
+#ifdef PARTICLE_STRING_COPY_ON_WRITE
+
+char *String::allocateBuffer(unsigned int maxStrLen)
+{
+    return allocateSharedBuffer(maxStrLen);
+}
+
+char *String::reallocateBuffer(char *ptr, unsigned int maxStrLen)
+{
+    // Only buffers that are not shared are reallocated
+    if (!ptr) {
+        return allocateBuffer(maxStrLen);
+    }
+    void *p = realloc(sharedBuffer(ptr), sizeof(SharedBuffer) + maxStrLen + 1);
+    if (!p) {
+        return nullptr;
+    }
+    new(p) SharedBuffer{1};
+    return (char *)p + sizeof(SharedBuffer);
+}
+
+void String::releaseBuffer(void)
+{
+    if (!(flags & FLAG_SSO)) {
+        releaseSharedBuffer(heap_.ptr);
+    }
+}
+
+inline bool String::isShared(void) const
+{
+    // Another thread may release its reference concurrently, in which case the buffer is copied
+    // unnecessarily, but no other thread can start sharing a buffer it doesn't have access to
+    return !(flags & FLAG_SSO) && heap_.ptr && sharedBuffer(heap_.ptr)->refs.load(std::memory_order_acquire) > 1;
+}
+
+inline bool String::isShareable(void) const
+{
+    return !(flags & (FLAG_SSO | FLAG_UNSHAREABLE)) && heap_.ptr;
+}
+
+bool String::isBufferUnique(void) const
+{
+    return !(flags & FLAG_SSO) && heap_.ptr && sharedBuffer(heap_.ptr)->refs.load(std::memory_order_acquire) == 1;
+}
+
+#else
+
+char *String::allocateBuffer(unsigned int maxStrLen)
+{
+    return (char *)malloc(maxStrLen + 1);
+}
+
+char *String::reallocateBuffer(char *ptr, unsigned int maxStrLen)
+{
+    return (char *)realloc(ptr, maxStrLen + 1);
+}
+
+void String::releaseBuffer(void)
+{
+    if (flags & FLAG_INTERNED) {
+        releaseSharedBuffer(heap_.ptr);
+    } else if (!(flags & FLAG_SSO)) {
+        free(heap_.ptr);
+    }
+}
+
+inline bool String::isShared(void) const
+{
+    // Only interned buffers are reference-counted, and they are never modified in place
+    return flags & FLAG_INTERNED;
+}
+
+inline bool String::isShareable(void) const
+{
+    return flags & FLAG_INTERNED;
+}
+
+bool String::isBufferUnique(void) const
+{
+    return (flags & FLAG_INTERNED) && sharedBuffer(heap_.ptr)->refs.load(std::memory_order_acquire) == 1;
+}
+
+#endif // PARTICLE_STRING_COPY_ON_WRITE
+
+inline unsigned char String::unshare(void)
+{
+    return !isShared() || changeBuffer(len);
+}
+
 inline void String::init(void)
 {
-    buffer = nullptr;
-    capacity_ = 0;
+    heap_.ptr = nullptr;
+    heap_.capacity = 0;
     len = 0;
     flags = 0;
 }
 
 void String::invalidate(void)
 {
-    if (buffer) {
-        free(buffer);
-    }
-    buffer = nullptr;
-    capacity_ = len = 0;
+    releaseBuffer();
+    init();
 }
 
 unsigned char String::reserve(unsigned int size)
 {
-    if (buffer && capacity_ >= size) {
+    if (buffer() && capacity() >= size && !isShared()) {
         return 1;
     }
     if (changeBuffer(size)) {
         if (len == 0) {
-            buffer[0] = 0;
+            buffer()[0] = 0;
         }
         return 1;
     }
     return 0;
 }
 
+unsigned char String::grow(unsigned int minStrLen)
+{
+    // Grow the capacity by a factor of 1.5 so that appending characters one by one takes amortized
+    // constant time
+    unsigned int cap = buffer() ? capacity() : 0;
+    if (cap <= UINT_MAX / 3 * 2) {
+        cap += cap / 2;
+        if (cap > minStrLen && reserve(cap)) {
+            return 1;
+        }
+    }
+    return reserve(minStrLen);
+}
+
 unsigned char String::changeBuffer(unsigned int maxStrLen)
 {
-    char *newbuffer = (char *)realloc(buffer, maxStrLen + 1);
+    if (flags & FLAG_SSO) {
+        if (maxStrLen <= SSO_CAPACITY) {
+            return 1;
+        }
+        char *newbuffer = allocateBuffer(maxStrLen);
+        if (!newbuffer) {
+            return 0;
+        }
+        memcpy(newbuffer, sso_, len + 1);
+        flags &= ~FLAG_SSO;
+        heap_.ptr = newbuffer;
+        heap_.capacity = maxStrLen;
+        return 1;
+    }
+    if (!heap_.ptr && maxStrLen <= SSO_CAPACITY) {
+        // Short strings are stored inline
+        flags |= FLAG_SSO;
+        return 1;
+    }
+    if (isShared()) {
+        // The other strings keep using the shared buffer
+        if (maxStrLen < len) {
+            maxStrLen = len;
+        }
+        char *newbuffer = allocateBuffer(maxStrLen);
+        if (!newbuffer) {
+            return 0;
+        }
+        memcpy(newbuffer, heap_.ptr, len + 1);
+        releaseBuffer();
+        flags &= ~FLAG_INTERNED;
+        heap_.ptr = newbuffer;
+        heap_.capacity = maxStrLen;
+        return 1;
+    }
+    char *newbuffer = reallocateBuffer(heap_.ptr, maxStrLen);
     if (newbuffer) {
-        buffer = newbuffer;
-        capacity_ = maxStrLen;
+        heap_.ptr = newbuffer;
+        heap_.capacity = maxStrLen;
         return 1;
     }
     return 0;
@@ -250,13 +398,17 @@ unsigned char String::changeBuffer(unsigned int maxStrLen)
 
 String & String::copy(const char *cstr, unsigned int length)
 {
+    if (isShared()) {
+        // Not copying the current contents of the buffer
+        invalidate();
+    }
     if (!reserve(length)) {
         invalidate();
         return *this;
     }
     len = length;
-    memcpy(buffer, cstr, length);
-    buffer[len] = 0;
+    memcpy(buffer(), cstr, length);
+    buffer()[len] = 0;
     return *this;
 }
 
@@ -264,25 +416,45 @@ String & String::copy(const __FlashStringHelper *pstr, unsigned int length) {
     return copy(reinterpret_cast<const char*>(pstr), length);
 }
 
+unsigned char String::copyInterned(const char *cstr, unsigned int length)
+{
+#ifdef PARTICLE_STRING_COPY_ON_WRITE
+    copy(cstr, length);
+    return buffer() != nullptr;
+#else
+    char *newbuffer = allocateSharedBuffer(length);
+    if (!newbuffer) {
+        invalidate();
+        return 0;
+    }
+    memcpy(newbuffer, cstr, length);
+    newbuffer[length] = 0;
+    releaseBuffer();
+    heap_.ptr = newbuffer;
+    heap_.capacity = length;
+    len = length;
+    flags = FLAG_INTERNED;
+    return 1;
+#endif
+}
+
 #ifdef __GXX_EXPERIMENTAL_CXX0X__
 void String::move(String &rhs)
 {
-    if (buffer) {
-        if (capacity_ >= rhs.len && rhs.buffer) {
-            strcpy(buffer, rhs.buffer);
-            len = rhs.len;
-            rhs.len = 0;
-            return;
-        } else {
-            free(buffer);
-        }
+    if ((rhs.flags & FLAG_SSO) && !(flags & FLAG_SSO) && heap_.ptr && heap_.capacity >= rhs.len && !isShared()) {
+        // Keep the already allocated buffer
+        memcpy(heap_.ptr, rhs.sso_, rhs.len + 1);
+        len = rhs.len;
+        rhs.invalidate();
+        return;
     }
-    buffer = rhs.buffer;
-    capacity_ = rhs.capacity_;
+    releaseBuffer();
+    // The inline buffer doesn't reference the object, so it can be moved as is
+    static_assert(sizeof(sso_) >= sizeof(heap_), "SSO buffer is too small");
+    memcpy(sso_, rhs.sso_, sizeof(sso_));
     len = rhs.len;
-    rhs.buffer = nullptr;
-    rhs.capacity_ = 0;
-    rhs.len = 0;
+    flags = rhs.flags;
+    rhs.init();
 }
 #endif
 
@@ -292,8 +464,18 @@ String & String::operator = (const String &rhs)
         return *this;
     }
 
-    if (rhs.buffer) {
-        copy(rhs.buffer, rhs.len);
+    if (rhs.isShareable()) {
+        // Share the buffer. The reference count is incremented first in case the buffer is
+        // already shared with rhs
+        sharedBuffer(rhs.heap_.ptr)->refs.fetch_add(1, std::memory_order_relaxed);
+        releaseBuffer();
+        heap_ = rhs.heap_;
+        len = rhs.len;
+        flags = rhs.flags & FLAG_INTERNED;
+        return *this;
+    }
+    if (rhs.buffer()) {
+        copy(rhs.buffer(), rhs.len);
     }
     else {
         invalidate();
@@ -350,7 +532,7 @@ String & String::operator = (const char *cstr)
 
 unsigned char String::concat(const String &s)
 {
-    return concat(s.buffer, s.len);
+    return concat(s.buffer(), s.len);
 }
 
 unsigned char String::concat(const char *cstr, unsigned int length)
@@ -362,11 +544,20 @@ unsigned char String::concat(const char *cstr, unsigned int length)
     if (length == 0) {
         return 1;
     }
-    if (!reserve(newlen)) {
-        return 0;
+    if (!buffer() || newlen > capacity() || isShared()) {
+        // The string may be concatenated with a part of itself
+        const char *buf = buffer();
+        const bool self = buf && cstr >= buf && cstr <= buf + len;
+        const unsigned int offs = cstr - buf;
+        if (!grow(newlen)) {
+            return 0;
+        }
+        if (self) {
+            cstr = buffer() + offs;
+        }
     }
-    memcpy(buffer + len, cstr, length);
-    buffer[newlen] = 0;
+    memcpy(buffer() + len, cstr, length);
+    buffer()[newlen] = 0;
     len = newlen;
     return 1;
 }
@@ -393,65 +584,73 @@ unsigned char String::concat(char c)
 
 unsigned char String::concat(unsigned char num)
 {
-    char buf[4] = {};
-    itoa(num, buf, 10);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
 }
 
 unsigned char String::concat(int num)
 {
-    char buf[7] = {};
-    itoa(num, buf, 10);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
 }
 
 unsigned char String::concat(unsigned int num)
 {
-    char buf[6] = {};
-    utoa(num, buf, 10);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
 }
 
 unsigned char String::concat(long num)
 {
-    char buf[12] = {};
-    ltoa(num, buf, 10);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
 }
 
 unsigned char String::concat(unsigned long num)
 {
-    char buf[11] = {};
-    ultoa(num, buf, DEC);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
 }
 
 unsigned char String::concat(long long num)
 {
-    char buf[66] = {};  // Assuming a maximum of 64-bit binary representation + '-' + null terminator.
-    std::to_chars(buf, buf + sizeof(buf) - 1, num, (int)DEC);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
 }
 
 unsigned char String::concat(unsigned long long num)
 {
-    char buf[65] = {};  // Assuming a maximum of 64-bit binary representation + null terminator.
-    std::to_chars(buf, buf + sizeof(buf) - 1, num, (int)DEC);
-    return concat(buf, strlen(buf));
+    char buf[MAX_INTEGER_STRING_LENGTH + 1];
+    return concat(buf, formatInteger(num, buf));
+}
+
+unsigned char String::concat(double num, int decimalPlaces)
+{
+    if (decimalPlaces < 0) {
+        decimalPlaces = 0;
+    }
+    // Most numbers fit in a buffer on the stack. Longer ones are formatted directly into the string
+    char buf[32];
+    const size_t n = formatDouble(num, decimalPlaces, buf, sizeof(buf));
+    if (n < sizeof(buf)) {
+        return concat(buf, n);
+    }
+    if (!reserve(len + n)) {
+        return 0;
+    }
+    formatDouble(num, decimalPlaces, buffer() + len, n + 1);
+    len += n;
+    return 1;
 }
 
 unsigned char String::concat(float num)
 {
-    char buf[20] = {};
-    dtoa(num, 6, buf);
-    return concat(buf, strlen(buf));
+    return concat((double)num, 6);
 }
 
 unsigned char String::concat(double num)
 {
-    char buf[20] = {};
-    dtoa(num, 6, buf);
-    return concat(buf, strlen(buf));
+    return concat((double)num, 6);
 }
 
 /*********************************************/
@@ -461,7 +660,7 @@ unsigned char String::concat(double num)
 StringSumHelper & operator + (const StringSumHelper &lhs, const String &rhs)
 {
     StringSumHelper &a = const_cast<StringSumHelper&>(lhs);
-    if (!a.concat(rhs.buffer, rhs.len)) {
+    if (!a.concat(rhs.buffer(), rhs.len)) {
         a.invalidate();
     }
     return a;
@@ -571,16 +770,20 @@ StringSumHelper & operator + (const StringSumHelper &lhs, double num)
 
 int String::compareTo(const String &s) const
 {
-    if (!buffer || !s.buffer) {
-        if (s.buffer && s.len > 0) {
-            return 0 - *(unsigned char *)s.buffer;
+    if (!buffer() || !s.buffer()) {
+        if (s.buffer() && s.len > 0) {
+            return 0 - *(unsigned char *)s.buffer();
         }
-        if (buffer && len > 0) {
-            return *(unsigned char *)buffer;
+        if (buffer() && len > 0) {
+            return *(unsigned char *)buffer();
         }
         return 0;
     }
-    return strcmp(buffer, s.buffer);
+    if (buffer() == s.buffer()) {
+        // shared or interned buffer
+        return 0;
+    }
+    return strcmp(buffer(), s.buffer());
 }
 
 unsigned char String::equals(const String &s2) const
@@ -594,9 +797,9 @@ unsigned char String::equals(const char *cstr) const
         return (cstr == nullptr || *cstr == 0);
     }
     if (cstr == nullptr) {
-        return buffer[0] == 0;
+        return buffer()[0] == 0;
     }
-    return strcmp(buffer, cstr) == 0;
+    return strcmp(buffer(), cstr) == 0;
 }
 
 unsigned char String::operator<(const String &rhs) const
@@ -630,14 +833,7 @@ unsigned char String::equalsIgnoreCase( const String &s2 ) const
     if (len == 0) {
         return 1;
     }
-    const char *p1 = buffer;
-    const char *p2 = s2.buffer;
-    while (*p1) {
-        if (tolower(*p1++) != tolower(*p2++)) {
-            return 0;
-        }
-    }
-    return 1;
+    return compareIgnoreCaseAscii(buffer(), s2.buffer(), len) == 0;
 }
 
 unsigned char String::startsWith( const String &s2 ) const
@@ -650,18 +846,18 @@ unsigned char String::startsWith( const String &s2 ) const
 
 unsigned char String::startsWith( const String &s2, unsigned int offset ) const
 {
-    if (offset > len - s2.len || !buffer || !s2.buffer) {
+    if (offset > len - s2.len || !buffer() || !s2.buffer()) {
         return 0;
     }
-    return strncmp( &buffer[offset], s2.buffer, s2.len ) == 0;
+    return strncmp( &buffer()[offset], s2.buffer(), s2.len ) == 0;
 }
 
 unsigned char String::endsWith( const String &s2 ) const
 {
-    if ( len < s2.len || !buffer || !s2.buffer) {
+    if ( len < s2.len || !buffer() || !s2.buffer()) {
         return 0;
     }
-    return strcmp(&buffer[len - s2.len], s2.buffer) == 0;
+    return strcmp(&buffer()[len - s2.len], s2.buffer()) == 0;
 }
 
 /*********************************************/
@@ -675,27 +871,30 @@ char String::charAt(unsigned int loc) const
 
 void String::setCharAt(unsigned int loc, char c)
 {
-    if (loc < len) {
-        buffer[loc] = c;
+    if (loc < len && unshare()) {
+        buffer()[loc] = c;
     }
 }
 
 char & String::operator[](unsigned int index)
 {
     static char dummy_writable_char;
-    if (index >= len || !buffer) {
+    if (index >= len || !buffer() || !unshare()) {
         dummy_writable_char = 0;
         return dummy_writable_char;
     }
-    return buffer[index];
+    // The character may be modified through the returned reference at any time later, so the
+    // buffer can no longer be shared
+    flags |= FLAG_UNSHAREABLE;
+    return buffer()[index];
 }
 
 char String::operator[]( unsigned int index ) const
 {
-    if (index >= len || !buffer) {
+    if (index >= len || !buffer()) {
         return 0;
     }
-    return buffer[index];
+    return buffer()[index];
 }
 
 void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index) const
@@ -711,7 +910,7 @@ void String::getBytes(unsigned char *buf, unsigned int bufsize, unsigned int ind
     if (n > len - index) {
         n = len - index;
     }
-    strncpy((char *)buf, buffer + index, n);
+    strncpy((char *)buf, buffer() + index, n);
     buf[n] = 0;
 }
 
@@ -726,14 +925,7 @@ int String::indexOf(char c) const
 
 int String::indexOf( char ch, unsigned int fromIndex ) const
 {
-    if (fromIndex >= len) {
-        return -1;
-    }
-    const char* temp = strchr(buffer + fromIndex, ch);
-    if (temp == nullptr) {
-        return -1;
-    }
-    return temp - buffer;
+    return spark::StringView(*this).indexOf(ch, fromIndex);
 }
 
 int String::indexOf(const String &s2) const
@@ -746,11 +938,7 @@ int String::indexOf(const String &s2, unsigned int fromIndex) const
     if (fromIndex >= len) {
         return -1;
     }
-    const char *found = strstr(buffer + fromIndex, s2.buffer);
-    if (found == nullptr) {
-        return -1;
-    }
-    return found - buffer;
+    return spark::StringView(*this).indexOf(s2, fromIndex);
 }
 
 int String::lastIndexOf( char theChar ) const
@@ -760,17 +948,7 @@ int String::lastIndexOf( char theChar ) const
 
 int String::lastIndexOf(char ch, unsigned int fromIndex) const
 {
-    if (fromIndex >= len) {
-        return -1;
-    }
-    char tempchar = buffer[fromIndex + 1];
-    buffer[fromIndex + 1] = '\0';
-    char* temp = strrchr( buffer, ch );
-    buffer[fromIndex + 1] = tempchar;
-    if (temp == nullptr) {
-        return -1;
-    }
-    return temp - buffer;
+    return spark::StringView(*this).lastIndexOf(ch, fromIndex);
 }
 
 int String::lastIndexOf(const String &s2) const
@@ -783,18 +961,7 @@ int String::lastIndexOf(const String &s2, unsigned int fromIndex) const
     if (s2.len == 0 || len == 0 || s2.len > len) {
         return -1;
     }
-    if (fromIndex >= len) fromIndex = len - 1;
-    int found = -1;
-    for (char *p = buffer; p <= buffer + fromIndex; p++) {
-        p = strstr(p, s2.buffer);
-        if (!p) {
-            break;
-        }
-        if ((unsigned int)(p - buffer) <= fromIndex) {
-            found = p - buffer;
-        }
-    }
-    return found;
+    return spark::StringView(*this).lastIndexOf(s2, fromIndex);
 }
 
 String String::substring( unsigned int left ) const
@@ -816,7 +983,7 @@ String String::substring(unsigned int left, unsigned int right) const
     if (right > len) {
         right = len;
     }
-    out.copy(&buffer[left], right - left);
+    out.copy(&buffer()[left], right - left);
     return out;
 }
 
@@ -826,8 +993,8 @@ String String::substring(unsigned int left, unsigned int right) const
 
 String& String::replace(char find, char replace)
 {
-    if (buffer) {
-        for (char *p = buffer; *p; p++) {
+    if (buffer() && unshare()) {
+        for (char *p = buffer(); *p; p++) {
             if (*p == find) *p = replace;
         }
     }
@@ -839,48 +1006,121 @@ String& String::replace(const String& find, const String& replace)
     if (len == 0 || find.len == 0) {
         return *this;
     }
-    int diff = replace.len - find.len;
-    char *readFrom = buffer;
-    char *foundAt;
-    if (diff == 0) {
-        while ((foundAt = strstr(readFrom, find.buffer)) != nullptr) {
-            memcpy(foundAt, replace.buffer, replace.len);
-            readFrom = foundAt + replace.len;
+    if (&find == this || &replace == this) {
+        return this->replace(String(find), String(replace));
+    }
+    const spark::StringView what(find);
+    int index = spark::StringView(*this).indexOf(what);
+    if (index < 0 || !unshare()) {
+        return *this;
+    }
+    // Compute the size of the result so that the buffer is resized at most once
+    unsigned int size = len;
+    if (replace.len > find.len) {
+        const spark::StringView src(*this);
+        for (int i = index; i >= 0; i = src.indexOf(what, i + find.len)) {
+            size += replace.len - find.len;
         }
-    } else if (diff < 0) {
-        char *writeTo = buffer;
-        while ((foundAt = strstr(readFrom, find.buffer)) != nullptr) {
-            unsigned int n = foundAt - readFrom;
-            memcpy(writeTo, readFrom, n);
-            writeTo += n;
-            memcpy(writeTo, replace.buffer, replace.len);
-            writeTo += replace.len;
-            readFrom = foundAt + find.len;
-            len += diff;
+        if (size > capacity() && !changeBuffer(size)) {
+            return *this; // XXX: tell user!
         }
-        strcpy(writeTo, readFrom);
-    } else {
-        unsigned int size = len; // compute size needed for result
-        while ((foundAt = strstr(readFrom, find.buffer)) != nullptr) {
-            readFrom = foundAt + find.len;
-            size += diff;
+    }
+    // If the string grows, move its contents to the end of the buffer first. This way the result
+    // can be written in a single pass from the beginning of the buffer without ever overwriting
+    // characters that haven't been read yet
+    char* const buf = buffer();
+    const unsigned int offs = size - len;
+    if (offs) {
+        memmove(buf + offs, buf, len);
+    }
+    const spark::StringView src(buf + offs, len);
+    char* dest = buf;
+    unsigned int pos = 0;
+    do {
+        const unsigned int n = index - pos;
+        if (dest != src.data() + pos) {
+            memmove(dest, src.data() + pos, n);
         }
-        if (size == len) {
-            return *this;
+        dest += n;
+        if (replace.len) {
+            memcpy(dest, replace.buffer(), replace.len);
+            dest += replace.len;
         }
-        if (size > capacity_ && !changeBuffer(size)) {
-            return *this; // XXX: tell user!
+        pos = index + find.len;
+        index = src.indexOf(what, pos);
+    } while (index >= 0);
+    memmove(dest, src.data() + pos, len - pos);
+    len = dest - buf + len - pos;
+    buf[len] = 0;
+    return *this;
+}
+
+String& String::replaceAll(const spark::PatternSet& patterns, const spark::StringView* replacements)
+{
+    return replaceMatches(patterns, replacements, 1);
+}
+
+String& String::replaceAll(const spark::PatternSet& patterns, spark::StringView replacement)
+{
+    // The same replacement is used for all patterns
+    return replaceMatches(patterns, &replacement, 0);
+}
+
+String& String::replaceMatches(const spark::PatternSet& patterns, const spark::StringView* replacements, unsigned int step)
+{
+    if (len == 0) {
+        return *this;
+    }
+    // Matches found while computing the size of the result are remembered so that the string
+    // usually doesn't need to be searched again
+    const unsigned int MAX_SAVED_MATCHES = 16;
+    spark::PatternMatch matches[MAX_SAVED_MATCHES];
+    unsigned int count = 0;
+    spark::StringView src(*this);
+    spark::PatternMatch m = patterns.find(src);
+    if (m.index < 0 || !unshare()) {
+        return *this;
+    }
+    // Replacements may both grow and shrink the string, and the result is written in place, so
+    // the text following each match needs to be moved as far as the largest growth of any prefix
+    int diff = 0;
+    int maxDiff = 0;
+    do {
+        if (count < MAX_SAVED_MATCHES) {
+            matches[count] = m;
         }
-        int index = len - 1;
-        while (index >= 0 && (index = lastIndexOf(find, index)) >= 0) {
-            readFrom = buffer + index + find.len;
-            memmove(readFrom + diff, readFrom, len - (readFrom - buffer));
-            len += diff;
-            buffer[len] = 0;
-            memcpy(buffer + index, replace.buffer, replace.len);
-            index--;
+        ++count;
+        diff += (int)replacements[m.pattern * step].size() - m.length;
+        if (diff > maxDiff) {
+            maxDiff = diff;
         }
-    }
+        m = patterns.find(src, m.index + m.length);
+    } while (m.index >= 0);
+    if (len + maxDiff > capacity() && !changeBuffer(len + maxDiff)) {
+        return *this; // XXX: tell user!
+    }
+    char* const buf = buffer();
+    if (maxDiff) {
+        memmove(buf + maxDiff, buf, len);
+    }
+    src = spark::StringView(buf + maxDiff, len);
+    char* dest = buf;
+    unsigned int pos = 0;
+    for (unsigned int i = 0; i < count; ++i) {
+        m = (i < MAX_SAVED_MATCHES) ? matches[i] : patterns.find(src, pos);
+        const unsigned int n = m.index - pos;
+        if (dest != src.data() + pos) {
+            memmove(dest, src.data() + pos, n);
+        }
+        dest += n;
+        const spark::StringView& r = replacements[m.pattern * step];
+        memcpy(dest, r.data(), r.size());
+        dest += r.size();
+        pos = m.index + m.length;
+    }
+    memmove(dest, src.data() + pos, len - pos);
+    len = dest - buf + len - pos;
+    buf[len] = 0;
     return *this;
 }
 
@@ -899,52 +1139,51 @@ String& String::remove(unsigned int index, unsigned int count){
     if (index + count > len) {
         count = len - index;
     }
-    char *writeTo = buffer + index;
+    if (!unshare()) {
+        return *this;
+    }
+    char *writeTo = buffer() + index;
     len = len - count;
-    memmove(writeTo, buffer + index + count,len - index);
-    buffer[len] = 0;
+    memmove(writeTo, buffer() + index + count,len - index);
+    buffer()[len] = 0;
     return *this;
 }
 
 String& String::toLowerCase(void)
 {
-    if (buffer) {
-        for (char *p = buffer; *p; p++) {
-            *p = tolower(*p);
-        }
+    if (buffer() && unshare()) {
+        toLowerCaseAscii(buffer(), len);
     }
     return *this;
 }
 
 String& String::toUpperCase(void)
 {
-    if (buffer) {
-        for (char *p = buffer; *p; p++) {
-            *p = toupper(*p);
-        }
+    if (buffer() && unshare()) {
+        toUpperCaseAscii(buffer(), len);
     }
     return *this;
 }
 
 String& String::trim(void)
 {
-    if (!buffer || len == 0) {
+    if (!buffer() || len == 0 || !unshare()) {
         return *this;
     }
-    char *begin = buffer;
-    while (isspace(*begin)) {
+    char *begin = buffer();
+    char *end = buffer() + len;
+    while (begin < end && isSpaceAscii(*begin)) {
         begin++;
     }
-    char *end = buffer + len - 1;
-    while (isspace(*end) && end >= begin) {
+    while (end > begin && isSpaceAscii(*(end - 1))) {
         end--;
     }
-    len = end + 1 - begin;
-    if (begin > buffer) {
-        memcpy(buffer, begin, len);
+    len = end - begin;
+    if (begin > buffer()) {
+        memmove(buffer(), begin, len);
     }
-    buffer[len] = 0;
-  return *this;
+    buffer()[len] = 0;
+    return *this;
 }
 
 /*********************************************/
@@ -953,32 +1192,32 @@ String& String::trim(void)
 
 long String::toInt(void) const
 {
-    if (buffer) {
-        return atol(buffer);
+    if (buffer()) {
+        return atol(buffer());
     }
     return 0;
 }
 
 long long String::toLongLongInt(unsigned char base) const
 {
-    if (buffer) {
-        return strtoll(buffer, nullptr, base);
+    if (buffer()) {
+        return strtoll(buffer(), nullptr, base);
     }
     return 0;
 }
 
 unsigned long long String::toULongLongInt(unsigned char base) const
 {
-    if (buffer) {
-        return strtoull(buffer, nullptr, base);
+    if (buffer()) {
+        return strtoull(buffer(), nullptr, base);
     }
     return 0;
 }
 
 float String::toFloat(void) const
 {
-    if (buffer) {
-        return float(atof(buffer));
+    if (buffer()) {
+        return float(atof(buffer()));
     }
     return 0;
 }
@@ -1001,9 +1240,9 @@ String String::format(const char* fmt, ...)
 
     String result;
     result.reserve(n);  // internally adds +1 for null terminator
-    if (result.buffer) {
+    if (result.buffer()) {
         va_start(marker, fmt);
-        n = vsnprintf(result.buffer, n+1, fmt, marker);
+        n = vsnprintf(result.buffer(), n+1, fmt, marker);
         va_end(marker);
         result.len = n;
     }
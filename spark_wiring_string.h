@@ -31,8 +31,11 @@
 #ifdef __cplusplus
 
 #include <stdarg.h>
+#include <string.h>
 #include "spark_wiring_print.h" // for HEX, DEC ... constants
 #include "spark_wiring_printable.h"
+#include "spark_wiring_vector.h"
+#include "spark_wiring_string_view.h"
 
 // When compiling programs with this class, the following gcc parameters
 // dramatically increase performance and memory (RAM) efficiency, typically
@@ -42,6 +45,11 @@
 
 class __FlashStringHelper;
 
+namespace spark {
+class PatternSet;
+class StringPool;
+} // namespace spark
+
 // This macro makes Hippomocks unhappy
 #ifndef UNIT_TEST
 #define F(X) (X)
@@ -51,6 +59,12 @@ class __FlashStringHelper;
 // result objects are assumed to be writable by subsequent concatenations.
 class StringSumHelper;
 
+// Define PARTICLE_STRING_COPY_ON_WRITE to let copies of a string share its
+// heap-allocated buffer. copying such a string only increments an atomic
+// reference count, and a private copy of the buffer is made when one of the
+// strings is modified. the macro needs to be defined the same way for the
+// library and the code using it
+
 // The string class
 class String
 {
@@ -68,6 +82,7 @@ public:
     // be false).
     String(const char *cstr = "");
     String(const char *cstr, unsigned int length);
+    explicit String(spark::StringView str);
     String(const String &str);
     String(const __FlashStringHelper *pstr);
         String(const Printable& printable);
@@ -95,7 +110,7 @@ public:
     inline unsigned int length(void) const {return len;}
 
     unsigned int capacity() const {
-        return capacity_;
+        return (flags & FLAG_SSO) ? SSO_CAPACITY : heap_.capacity;
     }
 
     // creates a copy of the assigned value.  if the value is null or
@@ -130,6 +145,23 @@ public:
     unsigned char concat(unsigned long long num);
     unsigned char concat(float num);
     unsigned char concat(double num);
+    unsigned char concat(double num, int decimalPlaces);
+
+    // concatenates all arguments (Strings, "strings" and chars) into a new
+    // string, allocating memory only once.  if the memory allocation fails,
+    // the returned string is invalid.  unlike a chain of operator + calls,
+    // this doesn't need to reallocate the result for every argument:
+    //     String s = String::concatAll(prefix, "/", name, '.', ext);
+    template<typename... ArgsT>
+    static String concatAll(const ArgsT&... args) {
+        String s;
+        if (!s.reserve((partLength(args) + ... + 0))) {
+            s.invalidate();
+            return s;
+        }
+        (s.concat(args), ...);
+        return s;
+    }
 
     // if there's not enough memory for the concatenated value, the string
     // will be left unchanged (but this isn't signalled in any way)
@@ -158,7 +190,7 @@ public:
     friend StringSumHelper & operator + (const StringSumHelper &lhs, double num);
 
     // comparison (only works w/ Strings and "strings")
-    operator StringIfHelperType() const { return buffer ? &String::StringIfHelper : 0; }
+    operator StringIfHelperType() const { return buffer() ? &String::StringIfHelper : 0; }
     int compareTo(const String &s) const;
     unsigned char equals(const String &s) const;
     unsigned char equals(const char *cstr) const;
@@ -174,6 +206,12 @@ public:
     unsigned char startsWith( const String &prefix) const;
     unsigned char startsWith(const String &prefix, unsigned int offset) const;
     unsigned char endsWith(const String &suffix) const;
+    // same as compareTo(), startsWith() and endsWith() but ignore the case of
+    // ASCII letters. these take views, so no temporary string is allocated
+    // when comparing with a C string
+    int compareIgnoreCase(spark::StringView str) const;
+    unsigned char startsWithIgnoreCase(spark::StringView prefix) const;
+    unsigned char endsWithIgnoreCase(spark::StringView suffix) const;
 
     // character acccess
     char charAt(unsigned int index) const;
@@ -183,7 +221,7 @@ public:
     void getBytes(unsigned char *buf, unsigned int bufsize, unsigned int index=0) const;
     void toCharArray(char *buf, unsigned int bufsize, unsigned int index=0) const
         {getBytes((unsigned char *)buf, bufsize, index);}
-    const char * c_str() const { return buffer; }
+    const char * c_str() const { return buffer(); }
 
     // search
     int indexOf( char ch ) const;
@@ -196,10 +234,45 @@ public:
     int lastIndexOf( const String &str, unsigned int fromIndex ) const;
     String substring( unsigned int beginIndex ) const;
     String substring( unsigned int beginIndex, unsigned int endIndex ) const;
+    // same as substring() but returns a view referencing the characters of
+    // this string instead of a copy
+    spark::StringView substringView( unsigned int beginIndex ) const &;
+    spark::StringView substringView( unsigned int beginIndex, unsigned int endIndex ) const &;
+    // splits the string into fields without allocating memory, see
+    // spark::StringView::split(). the fields reference the characters of
+    // this string and become invalid when the string is modified or destroyed
+    spark::StringSplitRange<spark::detail::CharDelimiter> split(char delim) const &;
+    spark::StringSplitRange<spark::detail::StringDelimiter> split(spark::StringView delim) const &;
+    spark::StringSplitRange<spark::detail::CharSetDelimiter> splitAny(spark::StringView delims) const &;
+    bool splitInto(spark::Vector<spark::StringView>& fields, char delim) const &;
+    bool splitInto(spark::Vector<spark::StringView>& fields, spark::StringView delim) const &;
+    bool splitAnyInto(spark::Vector<spark::StringView>& fields, spark::StringView delims) const &;
+    // the views would outlive a temporary string, so the methods above can't
+    // be called on one
+    spark::StringView substringView( unsigned int beginIndex ) const && = delete;
+    spark::StringView substringView( unsigned int beginIndex, unsigned int endIndex ) const && = delete;
+    spark::StringSplitRange<spark::detail::CharDelimiter> split(char delim) const && = delete;
+    spark::StringSplitRange<spark::detail::StringDelimiter> split(spark::StringView delim) const && = delete;
+    spark::StringSplitRange<spark::detail::CharSetDelimiter> splitAny(spark::StringView delims) const && = delete;
+    bool splitInto(spark::Vector<spark::StringView>& fields, char delim) const && = delete;
+    bool splitInto(spark::Vector<spark::StringView>& fields, spark::StringView delim) const && = delete;
+    bool splitAnyInto(spark::Vector<spark::StringView>& fields, spark::StringView delims) const && = delete;
+
+    // UTF-8 support, see spark::isValidUtf8(). the string is not required to
+    // contain valid UTF-8; invalid sequences are returned by codePoints() as
+    // spark::UTF8_REPLACEMENT_CHARACTER
+    unsigned char isValidUtf8() const;
+    unsigned int codePointCount() const;
+    spark::Utf8Range codePoints() const;
 
     // modification
     String& replace(char find, char replace);
     String& replace(const String& find, const String& replace);
+    // replaces all matches of a compiled pattern set in a single pass;
+    // replacements[i] is used for the i-th pattern of the set. The
+    // replacements must not reference this string
+    String& replaceAll(const spark::PatternSet& patterns, const spark::StringView* replacements);
+    String& replaceAll(const spark::PatternSet& patterns, spark::StringView replacement);
     String& remove(unsigned int index);
     String& remove(unsigned int index, unsigned int count);
     String& toLowerCase(void);
@@ -215,14 +288,43 @@ public:
         static String format(const char* format, ...);
 
 protected:
-    char *buffer;           // the actual char array
-    unsigned int capacity_;  // the array length minus one (for the '\0')
+    // Strings of up to SSO_CAPACITY characters are stored in the object itself
+    static const unsigned int SSO_CAPACITY = 15;
+
+    enum Flag {
+        FLAG_SSO = 0x01,        // the string is stored in sso_
+        FLAG_UNSHAREABLE = 0x02, // a writable reference to a character was returned, so the buffer is never shared
+        FLAG_INTERNED = 0x04    // the buffer was allocated by a spark::StringPool and is reference-counted
+    };
+
+    union {
+        struct {
+            char *ptr;              // the heap-allocated char array, or null if the string is invalid
+            unsigned int capacity;  // the array length minus one (for the '\0')
+        } heap_;
+        char sso_[SSO_CAPACITY + 1];
+    };
     unsigned int len;       // the String length (not counting the '\0')
-    unsigned char flags;    // unused, for future features
+    unsigned char flags;    // see Flag
 protected:
+    char *buffer() const { return (flags & FLAG_SSO) ? const_cast<char *>(sso_) : heap_.ptr; }
     void init(void);
     void invalidate(void);
+    unsigned char grow(unsigned int minStrLen);
     unsigned char changeBuffer(unsigned int maxStrLen);
+    // makes sure the buffer is not shared with other strings before it's
+    // modified in place
+    unsigned char unshare(void);
+    bool isShared(void) const;
+    bool isShareable(void) const;
+    static char *allocateBuffer(unsigned int maxStrLen);
+    static char *reallocateBuffer(char *ptr, unsigned int maxStrLen);
+    void releaseBuffer(void);
+    String& replaceMatches(const spark::PatternSet& patterns, const spark::StringView* replacements, unsigned int step);
+
+    static unsigned int partLength(const String &str) { return str.len; }
+    static unsigned int partLength(const char *cstr) { return cstr ? strlen(cstr) : 0; }
+    static unsigned int partLength(char) { return 1; }
 
     // copy and move
     String & copy(const char *cstr, unsigned int length);
@@ -231,6 +333,15 @@ protected:
     #ifdef __GXX_EXPERIMENTAL_CXX0X__
     void move(String &rhs);
     #endif
+
+    // makes a copy of the characters in a reference-counted buffer that
+    // copies of the string share even if copy-on-write is disabled
+    unsigned char copyInterned(const char *cstr, unsigned int length);
+    // returns true if no other string shares the heap-allocated buffer of
+    // this string. only reference-counted buffers are checked
+    bool isBufferUnique(void) const;
+
+    friend class spark::StringPool;
 };
 
 class StringSumHelper : public String
@@ -248,5 +359,95 @@ public:
     StringSumHelper(unsigned long long num) : String(num) {}
 };
 
+inline spark::StringView String::substringView(unsigned int beginIndex) const &
+{
+    return spark::StringView(*this).substring(beginIndex);
+}
+
+inline spark::StringView String::substringView(unsigned int beginIndex, unsigned int endIndex) const &
+{
+    return spark::StringView(*this).substring(beginIndex, endIndex);
+}
+
+inline int String::compareIgnoreCase(spark::StringView str) const
+{
+    return spark::StringView(*this).compareIgnoreCase(str);
+}
+
+inline unsigned char String::startsWithIgnoreCase(spark::StringView prefix) const
+{
+    return spark::StringView(*this).startsWithIgnoreCase(prefix);
+}
+
+inline unsigned char String::endsWithIgnoreCase(spark::StringView suffix) const
+{
+    return spark::StringView(*this).endsWithIgnoreCase(suffix);
+}
+
+inline unsigned char String::isValidUtf8() const
+{
+    return spark::isValidUtf8(buffer(), len);
+}
+
+inline unsigned int String::codePointCount() const
+{
+    return spark::countUtf8CodePoints(buffer(), len);
+}
+
+inline spark::Utf8Range String::codePoints() const
+{
+    return spark::Utf8Range(buffer(), len);
+}
+
+inline spark::StringSplitRange<spark::detail::CharDelimiter> String::split(char delim) const &
+{
+    return spark::StringView(*this).split(delim);
+}
+
+inline spark::StringSplitRange<spark::detail::StringDelimiter> String::split(spark::StringView delim) const &
+{
+    return spark::StringView(*this).split(delim);
+}
+
+inline spark::StringSplitRange<spark::detail::CharSetDelimiter> String::splitAny(spark::StringView delims) const &
+{
+    return spark::StringView(*this).splitAny(delims);
+}
+
+inline bool String::splitInto(spark::Vector<spark::StringView>& fields, char delim) const &
+{
+    return spark::StringView(*this).splitInto(fields, delim);
+}
+
+inline bool String::splitInto(spark::Vector<spark::StringView>& fields, spark::StringView delim) const &
+{
+    return spark::StringView(*this).splitInto(fields, delim);
+}
+
+inline bool String::splitAnyInto(spark::Vector<spark::StringView>& fields, spark::StringView delims) const &
+{
+    return spark::StringView(*this).splitAnyInto(fields, delims);
+}
+
+// spark::StringView
+inline spark::StringView::StringView(const String& str) :
+        data_(str.c_str() ? str.c_str() : ""),
+        size_(str.length()) {
+}
+
+inline String spark::StringView::toString() const {
+    return String(data_, size_);
+}
+
+inline spark::StringView::operator String() const {
+    return toString();
+}
+
+// String stores either a pointer to its heap-allocated buffer or the characters themselves, so it
+// can be moved with memcpy()
+template<>
+struct spark::IsTriviallyRelocatable<String>: std::true_type {
+};
+
 #endif  // __cplusplus
 #endif  // String_class_h
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_string_builder.h"
+#include "spark_wiring_error.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/uio.h>
+
+namespace spark {
+
+using particle::Error;
+
+namespace {
+
+// Maximum number of chunks passed to a single writev() call
+#ifdef IOV_MAX
+const int MAX_IOV_COUNT = (IOV_MAX < 64) ? IOV_MAX : 64;
+#else
+const int MAX_IOV_COUNT = 16;
+#endif
+
+} // namespace
+
+StringBuilder::StringBuilder(size_t chunkSize) :
+        head_(nullptr),
+        tail_(nullptr),
+        pos_(nullptr),
+        end_(nullptr),
+        fullSize_(0),
+        chunkSize_(chunkSize ? chunkSize : DEFAULT_CHUNK_SIZE) {
+}
+
+StringBuilder::StringBuilder(StringBuilder&& builder) :
+        StringBuilder(builder.chunkSize_) {
+    *this = std::move(builder);
+}
+
+StringBuilder::~StringBuilder() {
+    clear();
+}
+
+size_t StringBuilder::write(const uint8_t* data, size_t size) {
+    if (getWriteError()) {
+        return 0;
+    }
+    const size_t n = size;
+    while (size) {
+        if (pos_ == end_ && !addChunk(size)) {
+            setWriteError(Error::NO_MEMORY);
+            return 0;
+        }
+        size_t k = end_ - pos_;
+        if (k > size) {
+            k = size;
+        }
+        memcpy(pos_, data, k);
+        pos_ += k;
+        data += k;
+        size -= k;
+    }
+    return n;
+}
+
+size_t StringBuilder::length() const {
+    return tail_ ? fullSize_ + (pos_ - tail_->data()) : 0;
+}
+
+void StringBuilder::clear() {
+    Chunk* c = head_;
+    while (c) {
+        Chunk* next = c->next;
+        free(c);
+        c = next;
+    }
+    head_ = nullptr;
+    tail_ = nullptr;
+    pos_ = nullptr;
+    end_ = nullptr;
+    fullSize_ = 0;
+    clearWriteError();
+}
+
+String StringBuilder::toString() const {
+    String s;
+    if (!s.reserve(length())) {
+        return String((const char*)nullptr);
+    }
+    forEachChunk([&s](const char* data, size_t size) {
+        return s.concat(data, size); // Doesn't reallocate
+    });
+    return s;
+}
+
+int StringBuilder::writeTo(int fd) const {
+    struct iovec iov[MAX_IOV_COUNT];
+    const Chunk* c = head_;
+    size_t offs = 0; // Number of characters of the first chunk that were already written
+    for (;;) {
+        int count = 0;
+        for (const Chunk* it = c; it && count < MAX_IOV_COUNT; it = it->next) {
+            // Only the last chunk can be empty
+            const size_t n = (it == tail_) ? pos_ - tail_->data() : it->size;
+            if (!n) {
+                break;
+            }
+            iov[count].iov_base = (uint8_t*)(it + 1);
+            iov[count].iov_len = n;
+            ++count;
+        }
+        if (!count) {
+            break;
+        }
+        iov[0].iov_base = (uint8_t*)iov[0].iov_base + offs;
+        iov[0].iov_len -= offs;
+        const ssize_t r = ::writev(fd, iov, count);
+        if (r <= 0) {
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            return Error::IO;
+        }
+        // Skip the chunks that were written completely
+        size_t written = r;
+        for (int i = 0; i < count && written >= iov[i].iov_len; ++i) {
+            written -= iov[i].iov_len;
+            c = c->next;
+            offs = 0;
+        }
+        offs += written;
+    }
+    return 0;
+}
+
+size_t StringBuilder::printTo(Print& p) const {
+    size_t n = 0;
+    forEachChunk([&p, &n](const char* data, size_t size) {
+        n += p.write((const uint8_t*)data, size);
+        return true;
+    });
+    return n;
+}
+
+StringBuilder& StringBuilder::operator=(StringBuilder&& builder) {
+    if (this != &builder) {
+        clear();
+        head_ = builder.head_;
+        tail_ = builder.tail_;
+        pos_ = builder.pos_;
+        end_ = builder.end_;
+        fullSize_ = builder.fullSize_;
+        chunkSize_ = builder.chunkSize_;
+        setWriteError(builder.getWriteError());
+        builder.head_ = nullptr;
+        builder.tail_ = nullptr;
+        builder.pos_ = nullptr;
+        builder.end_ = nullptr;
+        builder.fullSize_ = 0;
+        builder.clearWriteError();
+    }
+    return *this;
+}
+
+bool StringBuilder::addChunk(size_t minSize) {
+    const size_t size = (minSize > chunkSize_) ? minSize : chunkSize_;
+    Chunk* c = (Chunk*)malloc(sizeof(Chunk) + size);
+    if (!c) {
+        return false;
+    }
+    c->next = nullptr;
+    c->size = size;
+    if (tail_) {
+        // Record the number of characters stored in the previous chunk
+        tail_->size = pos_ - tail_->data();
+        fullSize_ += tail_->size;
+        tail_->next = c;
+    } else {
+        head_ = c;
+    }
+    tail_ = c;
+    pos_ = c->data();
+    end_ = pos_ + size;
+    return true;
+}
+
+} // namespace spark
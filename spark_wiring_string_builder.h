@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_STRING_BUILDER_H
+#define SPARK_WIRING_STRING_BUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "spark_wiring_print.h"
+#include "spark_wiring_printable.h"
+#include "spark_wiring_string.h"
+
+namespace spark {
+
+/**
+ * An output stream that assembles a large string in chunks.
+ *
+ * Characters are appended to a linked list of fixed-size chunks, so the data written earlier is
+ * never reallocated or copied. Writes that are larger than the chunk size are stored in a
+ * dedicated chunk. On a memory allocation error, the write error is set to `Error::NO_MEMORY`
+ * and subsequent writes are ignored.
+ *
+ * The assembled data can be converted to a `String`, written to a file descriptor, or passed to
+ * a callback chunk by chunk. `StringBuilder` is also a `Printable`, so it can be printed to
+ * another stream.
+ *
+ * Example usage:
+ * ```
+ * StringBuilder b;
+ * JSONStreamWriter w(b);
+ * w.beginObject();
+ * w.name("value").value(123);
+ * w.endObject();
+ * String s = b.toString();
+ * ```
+ */
+class StringBuilder: public Print, public Printable {
+public:
+    /**
+     * Default chunk size.
+     */
+    static const size_t DEFAULT_CHUNK_SIZE = 1024;
+
+    /**
+     * Constructor.
+     *
+     * @param chunkSize Chunk size.
+     */
+    explicit StringBuilder(size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * Move constructor.
+     *
+     * @param builder Source builder.
+     */
+    StringBuilder(StringBuilder&& builder);
+
+    /**
+     * Destructor.
+     */
+    ~StringBuilder();
+
+    size_t write(uint8_t b) override {
+        if (pos_ != end_) {
+            *pos_++ = b;
+            return 1;
+        }
+        return write(&b, 1);
+    }
+
+    size_t write(const uint8_t* data, size_t size) override;
+
+    using Print::write;
+
+    /**
+     * Get the number of characters written.
+     *
+     * @return Number of characters.
+     */
+    size_t length() const;
+
+    /**
+     * Check if no characters have been written.
+     *
+     * @return `true` if the builder is empty, otherwise `false`.
+     */
+    bool isEmpty() const {
+        return !length();
+    }
+
+    /**
+     * Free all chunks and clear the write error.
+     */
+    void clear();
+
+    /**
+     * Convert the contents of the builder to a string.
+     *
+     * The string is allocated in one go.
+     *
+     * @return String. On a memory allocation error, an invalid string is returned.
+     */
+    String toString() const;
+
+    /**
+     * Write the contents of the builder to a file descriptor.
+     *
+     * The chunks are written with `writev()`. Partial and interrupted writes are retried.
+     *
+     * @param fd File descriptor.
+     * @return 0 on success, otherwise an error code defined by `Error::Type`.
+     */
+    int writeTo(int fd) const;
+
+    /**
+     * Call a function for each chunk.
+     *
+     * The function is called with a pointer to the characters of the chunk and their number,
+     * and should return `false` to stop the iteration.
+     *
+     * @param fn Function.
+     * @return `true` if the function was called for all chunks, otherwise `false`.
+     */
+    template<typename F>
+    bool forEachChunk(F fn) const {
+        for (Chunk* c = head_; c; c = c->next) {
+            const size_t n = (c == tail_) ? pos_ - c->data() : c->size;
+            if (n && !fn((const char*)c->data(), n)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t printTo(Print& p) const override;
+
+    StringBuilder& operator=(StringBuilder&& builder);
+
+    // This class is non-copyable
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size; // Number of characters stored in the chunk, or its capacity if it's the last one
+
+        uint8_t* data() {
+            return (uint8_t*)(this + 1);
+        }
+    };
+
+    Chunk* head_;
+    Chunk* tail_;
+    uint8_t* pos_; // Write position in the last chunk
+    uint8_t* end_; // End of the last chunk
+    size_t fullSize_; // Number of characters in all chunks but the last one
+    size_t chunkSize_;
+
+    bool addChunk(size_t minSize);
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::StringBuilder;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_STRING_BUILDER_H
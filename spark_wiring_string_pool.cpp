@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_string_pool.h"
+
+namespace spark {
+
+String StringPool::intern(StringView str) {
+    if (str.size() <= String::SSO_CAPACITY) {
+        return String(str);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = strings_.find(str);
+    if (it != strings_.end()) {
+        return it->first;
+    }
+    String s;
+    if (!s.copyInterned(str.data(), str.size())) {
+        return String((const char*)nullptr);
+    }
+    auto r = strings_.insert(std::move(s), Empty());
+    if (r.first == strings_.end()) {
+        return String((const char*)nullptr);
+    }
+    return r.first->first;
+}
+
+int StringPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return strings_.size();
+}
+
+void StringPool::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    strings_.clear();
+}
+
+int StringPool::purge() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int n = 0;
+    for (auto it = strings_.begin(); it != strings_.end();) {
+        // Strings can't start sharing a buffer of the pool without locking the mutex
+        if (it->first.isBufferUnique()) {
+            it = strings_.erase(it); // The last entry takes the place of the removed one
+            ++n;
+        } else {
+            ++it;
+        }
+    }
+    return n;
+}
+
+StringPool* StringPool::instance() {
+    static StringPool pool;
+    return &pool;
+}
+
+} // namespace spark
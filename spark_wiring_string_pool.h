@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_STRING_POOL_H
+#define SPARK_WIRING_STRING_POOL_H
+
+#include <mutex>
+
+#include "spark_wiring_hash_map.h"
+#include "spark_wiring_string.h"
+#include "spark_wiring_string_view.h"
+
+namespace spark {
+
+/**
+ * A pool of interned strings.
+ *
+ * Interning a string returns a `String` that shares an immutable, reference-counted buffer with
+ * all other strings interned in the same pool with the same contents. Copying such a string only
+ * increments the reference count, even if `PARTICLE_STRING_COPY_ON_WRITE` is not defined, and
+ * comparing two strings that share a buffer doesn't compare their characters. Modifying an
+ * interned string makes a private copy of its buffer first.
+ *
+ * Strings that are short enough to be stored in a `String` object itself are not added to the
+ * pool, as copying them doesn't allocate memory.
+ *
+ * An interned string remains valid after the pool is cleared or destroyed. The pool keeps every
+ * string added to it until it is cleared, so a long-lived pool that interns arbitrary strings
+ * should be purged periodically. All methods of this class are thread-safe.
+ *
+ * Example usage:
+ * ```
+ * StringPool pool;
+ * Variant v1 = Variant::fromJSON(json1, &pool);
+ * Variant v2 = Variant::fromJSON(json2, &pool); // The keys of v2 share buffers with the keys of v1
+ * ```
+ */
+class StringPool {
+public:
+    StringPool() = default;
+
+    /**
+     * Intern a string.
+     *
+     * @param str String.
+     * @return Interned string. On a memory allocation error, an invalid string is returned.
+     */
+    String intern(StringView str);
+
+    /**
+     * Get the number of strings in the pool.
+     *
+     * @return Number of strings.
+     */
+    int size() const;
+
+    /**
+     * Remove all strings from the pool.
+     *
+     * Previously interned strings keep sharing their buffers with each other, but strings
+     * interned after this call will not share buffers with them.
+     */
+    void clear();
+
+    /**
+     * Remove the strings that are not used outside the pool.
+     *
+     * @return Number of removed strings.
+     */
+    int purge();
+
+    /**
+     * Get the global pool.
+     *
+     * The global pool is never cleared automatically. Call `purge()` periodically if it is used
+     * to intern strings received from untrusted sources or strings that vary over time.
+     *
+     * @return Pool instance.
+     */
+    static StringPool* instance();
+
+    // This class is non-copyable
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+private:
+    struct Empty {
+    };
+
+    particle::HashMap<String, Empty> strings_;
+    mutable std::mutex mutex_;
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::StringPool;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_STRING_POOL_H
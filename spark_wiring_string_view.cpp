@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_string_view.h"
+#include "spark_wiring_string.h"
+#include "string_convert.h"
+
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace spark {
+
+using particle::detail::compareIgnoreCaseAscii;
+
+namespace {
+
+// Minimum needle size for which the Horspool algorithm is used. Shorter needles are searched by
+// filtering the candidate positions by their first and last character
+const size_t HORSPOOL_MIN_NEEDLE_SIZE = 32;
+
+// Horspool shift tables store shifts as bytes to keep them small enough for the stack
+const size_t MAX_HORSPOOL_SHIFT = 255;
+
+inline bool matchesInner(const char* s, const char* p, size_t m) {
+    // The first and last characters are already known to match
+    return m <= 2 || memcmp(s + 1, p + 1, m - 2) == 0;
+}
+
+// All the functions below expect 2 <= m <= n
+const char* findFiltered(const char* s, size_t n, const char* p, size_t m) {
+    const unsigned char first = p[0];
+    const unsigned char last = p[m - 1];
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i f = _mm_set1_epi8(first);
+    const __m128i l = _mm_set1_epi8(last);
+    for (; i + m + 15 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(s + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, f), _mm_cmpeq_epi8(b, l)));
+        while (mask) {
+            const unsigned bit = __builtin_ctz(mask);
+            if (matchesInner(s + i + bit, p, m)) {
+                return s + i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    const char* q = s + i;
+    const char* const end = s + n - m + 1;
+    while (q < end) {
+        q = (const char*)memchr(q, first, end - q);
+        if (!q) {
+            break;
+        }
+        if ((unsigned char)q[m - 1] == last && matchesInner(q, p, m)) {
+            return q;
+        }
+        ++q;
+    }
+    return nullptr;
+}
+
+const char* findLastFiltered(const char* s, size_t n, const char* p, size_t m) {
+    const unsigned char first = p[0];
+    const unsigned char last = p[m - 1];
+    size_t end = n - m + 1; // Number of candidate positions
+#if defined(__SSE2__)
+    const __m128i f = _mm_set1_epi8(first);
+    const __m128i l = _mm_set1_epi8(last);
+    while (end >= 16) {
+        const size_t i = end - 16;
+        const __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(s + i + m - 1));
+        unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, f), _mm_cmpeq_epi8(b, l)));
+        while (mask) {
+            const unsigned bit = 31 - __builtin_clz(mask);
+            if (matchesInner(s + i + bit, p, m)) {
+                return s + i + bit;
+            }
+            mask &= ~(1u << bit);
+        }
+        end = i;
+    }
+#endif
+    while (end > 0) {
+        --end;
+        if ((unsigned char)s[end] == first && (unsigned char)s[end + m - 1] == last && matchesInner(s + end, p, m)) {
+            return s + end;
+        }
+    }
+    return nullptr;
+}
+
+const char* findHorspool(const char* s, size_t n, const char* p, size_t m) {
+    uint8_t shift[256];
+    const size_t maxShift = (m < MAX_HORSPOOL_SHIFT) ? m : MAX_HORSPOOL_SHIFT;
+    memset(shift, maxShift, sizeof(shift));
+    for (size_t i = m - maxShift; i < m - 1; ++i) {
+        shift[(unsigned char)p[i]] = m - 1 - i;
+    }
+    const unsigned char last = p[m - 1];
+    size_t i = 0;
+    while (i <= n - m) {
+        const unsigned char c = s[i + m - 1];
+        if (c == last && memcmp(s + i, p, m - 1) == 0) {
+            return s + i;
+        }
+        i += shift[c];
+    }
+    return nullptr;
+}
+
+const char* findLastHorspool(const char* s, size_t n, const char* p, size_t m) {
+    uint8_t shift[256];
+    const size_t maxShift = (m < MAX_HORSPOOL_SHIFT) ? m : MAX_HORSPOOL_SHIFT;
+    memset(shift, maxShift, sizeof(shift));
+    for (size_t i = maxShift - 1; i > 0; --i) {
+        shift[(unsigned char)p[i]] = i;
+    }
+    const unsigned char first = p[0];
+    size_t i = n - m;
+    for (;;) {
+        const unsigned char c = s[i];
+        if (c == first && memcmp(s + i + 1, p + 1, m - 1) == 0) {
+            return s + i;
+        }
+        if (i < shift[c]) {
+            break;
+        }
+        i -= shift[c];
+    }
+    return nullptr;
+}
+
+const char* findLastChar(const char* s, size_t n, char ch) {
+#if defined(__SSE2__)
+    const __m128i c = _mm_set1_epi8(ch);
+    while (n >= 16) {
+        n -= 16;
+        const unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(s + n)), c));
+        if (mask) {
+            return s + n + 31 - __builtin_clz(mask);
+        }
+    }
+#endif
+    while (n > 0) {
+        --n;
+        if (s[n] == ch) {
+            return s + n;
+        }
+    }
+    return nullptr;
+}
+
+// Sets of up to this many characters are searched for by comparing each character with the input
+// separately. Larger sets are looked up in a bitmap
+const size_t MAX_SIMD_CHAR_SET_SIZE = 8;
+
+const char* findAnyOf(const char* s, size_t n, const char* chars, size_t count) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    if (count <= MAX_SIMD_CHAR_SET_SIZE) {
+        __m128i set[MAX_SIMD_CHAR_SET_SIZE];
+        for (size_t j = 0; j < count; ++j) {
+            set[j] = _mm_set1_epi8(chars[j]);
+        }
+        for (; i + 16 <= n; i += 16) {
+            const __m128i a = _mm_loadu_si128((const __m128i*)(s + i));
+            __m128i eq = _mm_cmpeq_epi8(a, set[0]);
+            for (size_t j = 1; j < count; ++j) {
+                eq = _mm_or_si128(eq, _mm_cmpeq_epi8(a, set[j]));
+            }
+            const unsigned mask = _mm_movemask_epi8(eq);
+            if (mask) {
+                return s + i + __builtin_ctz(mask);
+            }
+        }
+    }
+#endif
+    uint32_t bitmap[256 / 32] = {};
+    for (size_t j = 0; j < count; ++j) {
+        const unsigned char c = chars[j];
+        bitmap[c / 32] |= (uint32_t)1 << (c % 32);
+    }
+    for (; i < n; ++i) {
+        const unsigned char c = s[i];
+        if (bitmap[c / 32] & ((uint32_t)1 << (c % 32))) {
+            return s + i;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+bool StringView::equalsIgnoreCase(StringView str) const {
+    return size_ == str.size_ && compareIgnoreCaseAscii(data_, str.data_, size_) == 0;
+}
+
+int StringView::compareIgnoreCase(StringView str) const {
+    const size_t n = (size_ < str.size_) ? size_ : str.size_;
+    const int r = compareIgnoreCaseAscii(data_, str.data_, n);
+    if (r != 0) {
+        return r;
+    }
+    return (size_ < str.size_) ? -1 : (size_ > str.size_) ? 1 : 0;
+}
+
+bool StringView::startsWithIgnoreCase(StringView prefix) const {
+    return size_ >= prefix.size_ && compareIgnoreCaseAscii(data_, prefix.data_, prefix.size_) == 0;
+}
+
+bool StringView::endsWithIgnoreCase(StringView suffix) const {
+    return size_ >= suffix.size_ && compareIgnoreCaseAscii(data_ + size_ - suffix.size_, suffix.data_, suffix.size_) == 0;
+}
+
+int StringView::indexOf(StringView str, size_t fromIndex) const {
+    if (fromIndex > size_ || str.size_ > size_ - fromIndex) {
+        return -1;
+    }
+    if (!str.size_) {
+        return fromIndex;
+    }
+    if (str.size_ == 1) {
+        return indexOf(str.data_[0], fromIndex);
+    }
+    const char* const s = data_ + fromIndex;
+    const size_t n = size_ - fromIndex;
+    const char* p = nullptr;
+    if (str.size_ >= HORSPOOL_MIN_NEEDLE_SIZE) {
+        p = findHorspool(s, n, str.data_, str.size_);
+    } else {
+        p = findFiltered(s, n, str.data_, str.size_);
+    }
+    return p ? p - data_ : -1;
+}
+
+int StringView::indexOfAny(StringView chars, size_t fromIndex) const {
+    if (fromIndex >= size_ || chars.isEmpty()) {
+        return -1;
+    }
+    if (chars.size_ == 1) {
+        return indexOf(chars.data_[0], fromIndex);
+    }
+    const char* p = findAnyOf(data_ + fromIndex, size_ - fromIndex, chars.data_, chars.size_);
+    return p ? p - data_ : -1;
+}
+
+int StringView::lastIndexOf(char ch, size_t fromIndex) const {
+    if (fromIndex >= size_) {
+        return -1;
+    }
+    const char* p = findLastChar(data_, fromIndex + 1, ch);
+    return p ? p - data_ : -1;
+}
+
+int StringView::lastIndexOf(StringView str, size_t fromIndex) const {
+    if (str.size_ > size_) {
+        return -1;
+    }
+    if (fromIndex > size_ - str.size_) {
+        fromIndex = size_ - str.size_;
+    }
+    if (!str.size_) {
+        return fromIndex;
+    }
+    if (str.size_ == 1) {
+        return lastIndexOf(str.data_[0], fromIndex);
+    }
+    // Only the characters up to the end of the last candidate occurrence need to be searched
+    const size_t n = fromIndex + str.size_;
+    const char* p = nullptr;
+    if (str.size_ >= HORSPOOL_MIN_NEEDLE_SIZE) {
+        p = findLastHorspool(data_, n, str.data_, str.size_);
+    } else {
+        p = findLastFiltered(data_, n, str.data_, str.size_);
+    }
+    return p ? p - data_ : -1;
+}
+
+} // namespace spark
@@ -0,0 +1,589 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_STRING_VIEW_H
+#define SPARK_WIRING_STRING_VIEW_H
+
+#include <cstring>
+#include <cstddef>
+#include <iterator>
+#include <functional>
+
+#include "spark_wiring_utf8.h"
+#include "spark_wiring_vector.h"
+
+class String;
+
+namespace spark {
+
+namespace detail {
+
+class CharDelimiter;
+class CharSetDelimiter;
+class StringDelimiter;
+
+} // namespace detail
+
+template<typename DelimiterT>
+class StringSplitRange;
+
+/**
+ * A non-owning reference to a sequence of characters.
+ *
+ * The referenced characters are not required to be null-terminated. The view doesn't manage the
+ * lifetime of the characters, so it must not outlive the string it was created from.
+ *
+ * Search methods return an index relative to the beginning of the view, or -1 if nothing is found,
+ * similarly to the respective methods of `String`. Substrings are found by filtering candidate
+ * positions by their first and last character, which is vectorized where SSE2 is available, or
+ * with the Horspool algorithm for long needles.
+ */
+class StringView {
+public:
+    /**
+     * Construct an empty view.
+     */
+    constexpr StringView() :
+            data_(""),
+            size_(0) {
+    }
+
+    /**
+     * Construct a view referencing a null-terminated string.
+     *
+     * @param str String.
+     */
+    StringView(const char* str) :
+            data_(str ? str : ""),
+            size_(str ? strlen(str) : 0) {
+    }
+
+    /**
+     * Construct a view referencing a sequence of characters.
+     *
+     * @param data Characters.
+     * @param size Number of characters.
+     */
+    constexpr StringView(const char* data, size_t size) :
+            data_(data),
+            size_(size) {
+    }
+
+    /**
+     * Construct a view referencing the contents of a `String`.
+     *
+     * @param str String.
+     */
+    StringView(const String& str);
+
+    const char* data() const {
+        return data_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    size_t length() const {
+        return size_;
+    }
+
+    bool isEmpty() const {
+        return !size_;
+    }
+
+    const char* begin() const {
+        return data_;
+    }
+
+    const char* end() const {
+        return data_ + size_;
+    }
+
+    char charAt(size_t index) const {
+        return (index < size_) ? data_[index] : 0;
+    }
+
+    char operator[](size_t index) const {
+        return charAt(index);
+    }
+
+    int compareTo(StringView str) const;
+    bool equals(StringView str) const {
+        return size_ == str.size_ && (data_ == str.data_ || memcmp(data_, str.data_, size_) == 0);
+    }
+    bool equalsIgnoreCase(StringView str) const;
+    bool startsWith(StringView prefix) const {
+        return size_ >= prefix.size_ && memcmp(data_, prefix.data_, prefix.size_) == 0;
+    }
+    bool endsWith(StringView suffix) const {
+        return size_ >= suffix.size_ && memcmp(data_ + size_ - suffix.size_, suffix.data_, suffix.size_) == 0;
+    }
+
+    ///@{
+    /**
+     * Same as `compareTo()`, `startsWith()` and `endsWith()` but ignores the case of ASCII letters.
+     */
+    int compareIgnoreCase(StringView str) const;
+    bool startsWithIgnoreCase(StringView prefix) const;
+    bool endsWithIgnoreCase(StringView suffix) const;
+    ///@}
+
+    int indexOf(char ch, size_t fromIndex = 0) const;
+    int indexOf(StringView str, size_t fromIndex = 0) const;
+    int lastIndexOf(char ch) const;
+    int lastIndexOf(char ch, size_t fromIndex) const;
+    int lastIndexOf(StringView str) const;
+    int lastIndexOf(StringView str, size_t fromIndex) const;
+
+    /**
+     * Find the first occurrence of any of the given characters.
+     *
+     * @param chars Characters to search for.
+     * @param fromIndex Index of the character to start the search from.
+     * @return Index of the character found, or -1 if none of the characters can be found.
+     */
+    int indexOfAny(StringView chars, size_t fromIndex = 0) const;
+
+    /**
+     * Check if the view contains valid UTF-8.
+     *
+     * @see `spark::isValidUtf8()`
+     */
+    bool isValidUtf8() const {
+        return spark::isValidUtf8(data_, size_);
+    }
+
+    /**
+     * Get the number of UTF-8 code points in the view.
+     *
+     * @see `spark::countUtf8CodePoints()`
+     */
+    size_t codePointCount() const {
+        return countUtf8CodePoints(data_, size_);
+    }
+
+    /**
+     * Get a range of the UTF-8 code points in the view.
+     *
+     * Example:
+     * ```
+     * for (uint32_t codePoint: StringView("Grüße").codePoints()) {
+     *     // ...
+     * }
+     * ```
+     */
+    Utf8Range codePoints() const {
+        return Utf8Range(data_, size_);
+    }
+
+    ///@{
+    /**
+     * Split the view into fields.
+     *
+     * The returned range yields views referencing the fields of this view, so splitting doesn't
+     * allocate memory. Adjacent delimiters produce empty fields, and an empty view consists of a
+     * single empty field.
+     *
+     * Example:
+     * ```
+     * for (StringView field: StringView("a,b,c").split(',')) {
+     *     // ...
+     * }
+     * ```
+     *
+     * @param delim Delimiter. An empty string never matches.
+     * @return Range of fields.
+     */
+    StringSplitRange<detail::CharDelimiter> split(char delim) const;
+    StringSplitRange<detail::StringDelimiter> split(StringView delim) const;
+    ///@}
+
+    /**
+     * Split the view into fields separated by any of the given characters.
+     *
+     * @param delims Delimiter characters.
+     * @return Range of fields.
+     *
+     * @see `split()`
+     */
+    StringSplitRange<detail::CharSetDelimiter> splitAny(StringView delims) const;
+
+    ///@{
+    /**
+     * Split the view into fields and store them in a vector.
+     *
+     * The vector is cleared before the fields are added to it. Its capacity is retained, so reusing
+     * the same vector for multiple strings avoids allocating memory once it has grown large enough.
+     *
+     * @param fields Vector of fields.
+     * @param delim Delimiter.
+     * @return `true` on success, or `false` on a memory allocation error.
+     *
+     * @see `split()`
+     */
+    bool splitInto(Vector<StringView>& fields, char delim) const;
+    bool splitInto(Vector<StringView>& fields, StringView delim) const;
+    ///@}
+
+    /**
+     * Split the view into fields separated by any of the given characters and store them in a
+     * vector.
+     *
+     * @param fields Vector of fields.
+     * @param delims Delimiter characters.
+     * @return `true` on success, or `false` on a memory allocation error.
+     *
+     * @see `splitInto()`
+     */
+    bool splitAnyInto(Vector<StringView>& fields, StringView delims) const;
+
+    /**
+     * Get a view referencing a part of this view.
+     *
+     * The indices are clamped to the size of the view.
+     *
+     * @param beginIndex Index of the first character.
+     * @param endIndex Index of the character following the last character.
+     * @return View.
+     */
+    StringView substring(size_t beginIndex) const {
+        return substring(beginIndex, size_);
+    }
+    StringView substring(size_t beginIndex, size_t endIndex) const;
+
+    /**
+     * Copy the referenced characters to a `String`.
+     *
+     * @return String.
+     */
+    String toString() const;
+
+    explicit operator String() const;
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+inline bool operator==(StringView str1, StringView str2) {
+    return str1.equals(str2);
+}
+
+inline bool operator!=(StringView str1, StringView str2) {
+    return !str1.equals(str2);
+}
+
+inline bool operator<(StringView str1, StringView str2) {
+    return str1.compareTo(str2) < 0;
+}
+
+inline bool operator>(StringView str1, StringView str2) {
+    return str1.compareTo(str2) > 0;
+}
+
+inline bool operator<=(StringView str1, StringView str2) {
+    return str1.compareTo(str2) <= 0;
+}
+
+inline bool operator>=(StringView str1, StringView str2) {
+    return str1.compareTo(str2) >= 0;
+}
+
+namespace detail {
+
+// Delimiters used by StringSplitIterator. find() returns the index of the next delimiter in a
+// string or -1, and size() returns the number of characters to skip after it
+class CharDelimiter {
+public:
+    explicit CharDelimiter(char ch = 0) :
+            ch_(ch) {
+    }
+
+    int find(StringView str, size_t fromIndex) const {
+        return str.indexOf(ch_, fromIndex);
+    }
+
+    size_t size() const {
+        return 1;
+    }
+
+private:
+    char ch_;
+};
+
+class CharSetDelimiter {
+public:
+    explicit CharSetDelimiter(StringView chars = StringView()) :
+            chars_(chars) {
+    }
+
+    int find(StringView str, size_t fromIndex) const {
+        return str.indexOfAny(chars_, fromIndex);
+    }
+
+    size_t size() const {
+        return 1;
+    }
+
+private:
+    StringView chars_;
+};
+
+class StringDelimiter {
+public:
+    explicit StringDelimiter(StringView str = StringView()) :
+            str_(str) {
+    }
+
+    int find(StringView str, size_t fromIndex) const {
+        return str_.isEmpty() ? -1 : str.indexOf(str_, fromIndex);
+    }
+
+    size_t size() const {
+        return str_.size();
+    }
+
+private:
+    StringView str_;
+};
+
+} // namespace detail
+
+/**
+ * An iterator over the fields of a string.
+ *
+ * @see `StringView::split()`
+ */
+template<typename DelimiterT>
+class StringSplitIterator {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef StringView value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const StringView* pointer;
+    typedef const StringView& reference;
+
+    StringSplitIterator() :
+            pos_(END) {
+    }
+
+    StringSplitIterator(StringView str, DelimiterT delim) :
+            str_(str),
+            delim_(delim),
+            pos_(0) {
+        next();
+    }
+
+    reference operator*() const {
+        return field_;
+    }
+
+    pointer operator->() const {
+        return &field_;
+    }
+
+    StringSplitIterator& operator++() {
+        if (field_.end() == str_.end()) {
+            pos_ = END;
+        } else {
+            pos_ = field_.end() - str_.begin() + delim_.size();
+            next();
+        }
+        return *this;
+    }
+
+    StringSplitIterator operator++(int) {
+        StringSplitIterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    bool operator==(const StringSplitIterator& it) const {
+        return pos_ == it.pos_;
+    }
+
+    bool operator!=(const StringSplitIterator& it) const {
+        return pos_ != it.pos_;
+    }
+
+private:
+    static const size_t END = (size_t)-1;
+
+    StringView str_;
+    StringView field_;
+    DelimiterT delim_;
+    size_t pos_; // Index of the current field, or END
+
+    void next() {
+        const int i = delim_.find(str_, pos_);
+        field_ = str_.substring(pos_, (i >= 0) ? (size_t)i : str_.size());
+    }
+};
+
+/**
+ * A range of the fields of a string.
+ *
+ * @see `StringView::split()`
+ */
+template<typename DelimiterT>
+class StringSplitRange {
+public:
+    typedef StringSplitIterator<DelimiterT> Iterator;
+
+    StringSplitRange(StringView str, DelimiterT delim) :
+            str_(str),
+            delim_(delim) {
+    }
+
+    Iterator begin() const {
+        return Iterator(str_, delim_);
+    }
+
+    Iterator end() const {
+        return Iterator();
+    }
+
+    /**
+     * Store the fields in a vector.
+     *
+     * @param fields Vector of fields. The vector is cleared before the fields are added to it.
+     * @return `true` on success, or `false` on a memory allocation error.
+     */
+    bool toVector(Vector<StringView>& fields) const {
+        fields.clear();
+        for (StringView field: *this) {
+            if (!fields.append(field)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    StringView str_;
+    DelimiterT delim_;
+};
+
+/**
+ * A comparator for `String`, `StringView` and C strings.
+ *
+ * Unlike `std::less<String>`, it doesn't create a temporary `String` object when a `String` is
+ * compared with a C string or a `StringView`, which makes it suitable for heterogeneous lookups in
+ * an ordered container.
+ */
+struct StringLess {
+    typedef void is_transparent;
+
+    bool operator()(StringView str1, StringView str2) const {
+        return str1.compareTo(str2) < 0;
+    }
+};
+
+} // namespace spark
+
+/**
+ * `std::less<String>` is made transparent, so that an ordered container of strings, such as
+ * `Map<String, T>`, can be searched by a C string or a `StringView` without creating a temporary
+ * `String` object for every comparison.
+ */
+template<>
+struct std::less<String>: spark::StringLess {
+};
+
+namespace particle {
+
+using ::spark::StringView;
+using ::spark::StringLess;
+using ::spark::StringSplitIterator;
+using ::spark::StringSplitRange;
+
+} // namespace particle
+
+// spark::StringView
+inline int spark::StringView::compareTo(StringView str) const {
+    const size_t n = (size_ < str.size_) ? size_ : str.size_;
+    // Views of the same string, such as interned strings, are compared by size
+    const int r = (data_ == str.data_) ? 0 : memcmp(data_, str.data_, n);
+    if (r != 0) {
+        return r;
+    }
+    return (size_ < str.size_) ? -1 : (size_ > str.size_) ? 1 : 0;
+}
+
+inline int spark::StringView::indexOf(char ch, size_t fromIndex) const {
+    if (fromIndex >= size_) {
+        return -1;
+    }
+    auto p = (const char*)memchr(data_ + fromIndex, (unsigned char)ch, size_ - fromIndex);
+    if (!p) {
+        return -1;
+    }
+    return p - data_;
+}
+
+inline int spark::StringView::lastIndexOf(char ch) const {
+    return size_ ? lastIndexOf(ch, size_ - 1) : -1;
+}
+
+inline int spark::StringView::lastIndexOf(StringView str) const {
+    if (str.size_ > size_) {
+        return -1;
+    }
+    return lastIndexOf(str, size_ - str.size_);
+}
+
+inline spark::StringSplitRange<spark::detail::CharDelimiter> spark::StringView::split(char delim) const {
+    return StringSplitRange<detail::CharDelimiter>(*this, detail::CharDelimiter(delim));
+}
+
+inline spark::StringSplitRange<spark::detail::StringDelimiter> spark::StringView::split(StringView delim) const {
+    return StringSplitRange<detail::StringDelimiter>(*this, detail::StringDelimiter(delim));
+}
+
+inline spark::StringSplitRange<spark::detail::CharSetDelimiter> spark::StringView::splitAny(StringView delims) const {
+    return StringSplitRange<detail::CharSetDelimiter>(*this, detail::CharSetDelimiter(delims));
+}
+
+inline bool spark::StringView::splitInto(Vector<StringView>& fields, char delim) const {
+    return split(delim).toVector(fields);
+}
+
+inline bool spark::StringView::splitInto(Vector<StringView>& fields, StringView delim) const {
+    return split(delim).toVector(fields);
+}
+
+inline bool spark::StringView::splitAnyInto(Vector<StringView>& fields, StringView delims) const {
+    return splitAny(delims).toVector(fields);
+}
+
+inline spark::StringView spark::StringView::substring(size_t beginIndex, size_t endIndex) const {
+    if (beginIndex > endIndex) {
+        const size_t i = beginIndex;
+        beginIndex = endIndex;
+        endIndex = i;
+    }
+    if (beginIndex > size_) {
+        return StringView(data_ + size_, 0);
+    }
+    if (endIndex > size_) {
+        endIndex = size_;
+    }
+    return StringView(data_ + beginIndex, endIndex - beginIndex);
+}
+
+#endif // SPARK_WIRING_STRING_VIEW_H
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spark_wiring_utf8.h"
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace spark {
+
+namespace {
+
+const uint64_t SWAR_HIGH_BITS = 0x8080808080808080ull;
+
+// Returns the number of ASCII characters at the beginning of a sequence
+size_t asciiPrefixLength(const char* s, size_t n) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        const unsigned mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(s + i)));
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, s + i, 8);
+        if (w & SWAR_HIGH_BITS) {
+            break;
+        }
+    }
+    while (i < n && !(s[i] & 0x80)) {
+        ++i;
+    }
+    return i;
+}
+
+} // namespace
+
+bool isValidUtf8(const char* data, size_t size) {
+    size_t i = 0;
+    while (i < size) {
+        i += asciiPrefixLength(data + i, size - i);
+        // Non-ASCII text tends to consist mostly of multibyte sequences, so they are decoded one by
+        // one until the next ASCII character
+        uint32_t codePoint = 0;
+        while (i < size && (data[i] & 0x80)) {
+            const int n = detail::decodeUtf8(data + i, size - i, &codePoint);
+            if (n < 0) {
+                return false;
+            }
+            i += n;
+        }
+    }
+    return true;
+}
+
+size_t countUtf8CodePoints(const char* data, size_t size) {
+    // Count the continuation bytes, which have the form 10xxxxxx
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    // Continuation bytes are the bytes less than or equal to -65 when interpreted as signed
+    const __m128i maxCont = _mm_set1_epi8(-64);
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        count += __builtin_popcount(_mm_movemask_epi8(_mm_cmplt_epi8(v, maxCont)));
+    }
+#endif
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        memcpy(&w, data + i, 8);
+        count += __builtin_popcountll(w & ~(w << 1) & SWAR_HIGH_BITS);
+    }
+    for (; i < size; ++i) {
+        if ((data[i] & 0xc0) == 0x80) {
+            ++count;
+        }
+    }
+    return size - count;
+}
+
+namespace detail {
+
+int decodeUtf8(const char* data, size_t size, uint32_t* codePoint) {
+    const uint8_t* const s = (const uint8_t*)data;
+    const uint8_t c = s[0];
+    if (c < 0x80) {
+        *codePoint = c;
+        return 1;
+    }
+    // Valid ranges of the second byte are narrower for some lead bytes. See the "Well-Formed UTF-8
+    // Byte Sequences" table in the Unicode standard
+    int n = 0;
+    uint32_t cp = 0;
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xbf;
+    if (c < 0xc2) {
+        return -1; // Continuation byte or overlong 2-byte sequence
+    } else if (c < 0xe0) {
+        n = 2;
+        cp = c & 0x1f;
+    } else if (c < 0xf0) {
+        n = 3;
+        cp = c & 0x0f;
+        if (c == 0xe0) {
+            lo = 0xa0; // Overlong
+        } else if (c == 0xed) {
+            hi = 0x9f; // Surrogate
+        }
+    } else if (c < 0xf5) {
+        n = 4;
+        cp = c & 0x07;
+        if (c == 0xf0) {
+            lo = 0x90; // Overlong
+        } else if (c == 0xf4) {
+            hi = 0x8f; // Above U+10FFFF
+        }
+    } else {
+        return -1;
+    }
+    for (int i = 1; i < n; ++i) {
+        if ((size_t)i >= size || s[i] < lo || s[i] > hi) {
+            return -i;
+        }
+        cp = (cp << 6) | (s[i] & 0x3f);
+        lo = 0x80;
+        hi = 0xbf;
+    }
+    *codePoint = cp;
+    return n;
+}
+
+} // namespace detail
+
+} // namespace spark
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARK_WIRING_UTF8_H
+#define SPARK_WIRING_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace spark {
+
+/**
+ * Code point used in place of invalid UTF-8 sequences.
+ */
+const uint32_t UTF8_REPLACEMENT_CHARACTER = 0xfffd;
+
+/**
+ * Check if a sequence of characters is valid UTF-8.
+ *
+ * Overlong encodings, encoded UTF-16 surrogates and code points above U+10FFFF are rejected as
+ * required by RFC 3629. Runs of ASCII characters are checked 16 characters at a time.
+ *
+ * @param data Characters.
+ * @param size Number of characters.
+ * @return `true` if the characters are valid UTF-8, otherwise `false`.
+ */
+bool isValidUtf8(const char* data, size_t size);
+
+/**
+ * Count the code points in a sequence of UTF-8 characters.
+ *
+ * The characters are expected to be valid UTF-8. For invalid data, the result is the number of
+ * characters that are not continuation bytes, and it may differ from the number of code points
+ * produced by `Utf8Iterator`.
+ *
+ * @param data Characters.
+ * @param size Number of characters.
+ * @return Number of code points.
+ */
+size_t countUtf8CodePoints(const char* data, size_t size);
+
+namespace detail {
+
+// Decodes a multibyte sequence. Returns the size of the sequence if it's valid. Otherwise, returns
+// the negated size of the longest prefix of the sequence that can't be valid, which is at least 1
+int decodeUtf8(const char* data, size_t size, uint32_t* codePoint);
+
+} // namespace detail
+
+/**
+ * An iterator over the code points of a UTF-8 string.
+ *
+ * Each invalid sequence is decoded as `UTF8_REPLACEMENT_CHARACTER`. Following the recommendation
+ * of the Unicode standard, the longest prefix of the sequence that can't be valid is replaced, so
+ * decoding resynchronizes at the next character that may start a valid sequence.
+ *
+ * @see `StringView::codePoints()`
+ */
+class Utf8Iterator {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef uint32_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const uint32_t* pointer;
+    typedef uint32_t reference;
+
+    Utf8Iterator() :
+            p_(nullptr),
+            end_(nullptr),
+            codePoint_(0),
+            size_(0),
+            valid_(false) {
+    }
+
+    Utf8Iterator(const char* data, const char* end) :
+            p_(data),
+            end_(end),
+            codePoint_(0),
+            size_(0),
+            valid_(false) {
+        next();
+    }
+
+    uint32_t operator*() const {
+        return codePoint_;
+    }
+
+    Utf8Iterator& operator++() {
+        p_ += size_;
+        next();
+        return *this;
+    }
+
+    Utf8Iterator operator++(int) {
+        Utf8Iterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    bool operator==(const Utf8Iterator& it) const {
+        return p_ == it.p_;
+    }
+
+    bool operator!=(const Utf8Iterator& it) const {
+        return p_ != it.p_;
+    }
+
+    /**
+     * Get a pointer to the characters of the current code point.
+     */
+    const char* position() const {
+        return p_;
+    }
+
+    /**
+     * Get the number of characters used to encode the current code point.
+     */
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * Check if the current code point is encoded correctly.
+     */
+    bool isValid() const {
+        return valid_;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+    uint32_t codePoint_;
+    unsigned size_;
+    bool valid_;
+
+    void next() {
+        if (p_ == end_) {
+            size_ = 0;
+            valid_ = false;
+        } else if (!(*p_ & 0x80)) {
+            codePoint_ = *p_;
+            size_ = 1;
+            valid_ = true;
+        } else {
+            const int n = detail::decodeUtf8(p_, end_ - p_, &codePoint_);
+            valid_ = n > 0;
+            if (valid_) {
+                size_ = n;
+            } else {
+                codePoint_ = UTF8_REPLACEMENT_CHARACTER;
+                size_ = -n;
+            }
+        }
+    }
+};
+
+/**
+ * A range of the code points of a UTF-8 string.
+ *
+ * @see `StringView::codePoints()`
+ */
+class Utf8Range {
+public:
+    typedef Utf8Iterator Iterator;
+
+    Utf8Range(const char* data, size_t size) :
+            data_(data),
+            size_(size) {
+    }
+
+    Iterator begin() const {
+        return Iterator(data_, data_ + size_);
+    }
+
+    Iterator end() const {
+        return Iterator(data_ + size_, data_ + size_);
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+} // namespace spark
+
+namespace particle {
+
+using ::spark::UTF8_REPLACEMENT_CHARACTER;
+using ::spark::isValidUtf8;
+using ::spark::countUtf8CodePoints;
+using ::spark::Utf8Iterator;
+using ::spark::Utf8Range;
+
+} // namespace particle
+
+#endif // SPARK_WIRING_UTF8_H
@@ -337,7 +337,28 @@ int encodeToCbor(EncodingStream& stream, const Variant& var) {
     return 0;
 }
 
-int decodeFromCbor(DecodingStream& stream, const CborHead& head, Variant& var) {
+// Reads a map key. Keys of definite length that fit in a buffer on the stack are interned without
+// allocating a temporary string
+int readCborKey(DecodingStream& stream, const CborHead& head, StringPool* keyPool, String& key) {
+    if (!keyPool) {
+        return readCborString(stream, head, key);
+    }
+    char buf[128];
+    if (head.detail != 31 /* Indefinite length */ && head.arg <= sizeof(buf)) {
+        CHECK(stream.read(buf, head.arg));
+        key = keyPool->intern(StringView(buf, head.arg));
+    } else {
+        String s;
+        CHECK(readCborString(stream, head, s));
+        key = keyPool->intern(s);
+    }
+    if (!key.c_str()) {
+        return Error::NO_MEMORY;
+    }
+    return 0;
+}
+
+int decodeFromCbor(DecodingStream& stream, const CborHead& head, Variant& var, StringPool* keyPool) {
     switch (head.type) {
     case 0: { // Unsigned integer
         if (head.arg <= std::numeric_limits<unsigned>::max()) {
@@ -393,7 +414,7 @@ int decodeFromCbor(DecodingStream& stream, const CborHead& head, Variant& var) {
                 break;
             }
             Variant v;
-            CHECK(decodeFromCbor(stream, h, v));
+            CHECK(decodeFromCbor(stream, h, v, keyPool));
             if (!arr.append(std::move(v))) {
                 return Error::NO_MEMORY;
             }
@@ -429,10 +450,10 @@ int decodeFromCbor(DecodingStream& stream, const CborHead& head, Variant& var) {
                 return Error::NOT_SUPPORTED; // Non-string keys are not supported
             }
             String k;
-            CHECK(readCborString(stream, h, k));
+            CHECK(readCborKey(stream, h, keyPool, k));
             Variant v;
             CHECK(readCborHead(stream, h));
-            CHECK(decodeFromCbor(stream, h, v));
+            CHECK(decodeFromCbor(stream, h, v, keyPool));
             if (!map.set(std::move(k), std::move(v))) {
                 return Error::NO_MEMORY;
             }
@@ -446,7 +467,7 @@ int decodeFromCbor(DecodingStream& stream, const CborHead& head, Variant& var) {
         do {
             CHECK(readCborHead(stream, h));
         } while (h.type == 6 /* Tagged item */);
-        CHECK(decodeFromCbor(stream, h, var));
+        CHECK(decodeFromCbor(stream, h, var, keyPool));
         break;
     }
     case 7: { // Misc. items
@@ -512,7 +533,7 @@ int decodeFromCbor(DecodingStream& stream, const CborHead& head, Variant& var) {
     return 0;
 }
 
-int decodeFromJson(const JSONValue& val, Variant& var) {
+int decodeFromJson(const JSONValue& val, Variant& var, StringPool* keyPool) {
     switch (val.type()) {
     case JSONType::JSON_TYPE_INVALID: {
         return Error::INVALID_ARGUMENT;
@@ -562,7 +583,7 @@ int decodeFromJson(const JSONValue& val, Variant& var) {
         }
         while (it.next()) {
             Variant v;
-            CHECK(decodeFromJson(it.value(), v));
+            CHECK(decodeFromJson(it.value(), v, keyPool));
             arr.append(std::move(v));
         }
         break;
@@ -575,12 +596,12 @@ int decodeFromJson(const JSONValue& val, Variant& var) {
         }
         while (it.next()) {
             JSONString jsonKey = it.name();
-            String k(jsonKey);
+            String k = keyPool ? keyPool->intern(StringView(jsonKey.data(), jsonKey.size())) : String(jsonKey);
             if (k.length() != jsonKey.size()) {
                 return Error::NO_MEMORY;
             }
             Variant v;
-            CHECK(decodeFromJson(it.value(), v));
+            CHECK(decodeFromJson(it.value(), v, keyPool));
             map.set(std::move(k), std::move(v));
         }
         break;
@@ -713,6 +734,14 @@ bool Variant::set(String&& key, Variant val) {
     return map.set(std::move(key), std::move(val));
 }
 
+bool Variant::set(StringView key, Variant val) {
+    auto& map = asMap();
+    if (!ensureCapacity(map, 1)) {
+        return false;
+    }
+    return map.set(key, std::move(val));
+}
+
 bool Variant::remove(const char* key) {
     if (!isMap()) {
         return false;
@@ -727,6 +756,13 @@ bool Variant::remove(const String& key) {
     return value<VariantMap>().remove(key);
 }
 
+bool Variant::remove(StringView key) {
+    if (!isMap()) {
+        return false;
+    }
+    return value<VariantMap>().remove(key);
+}
+
 Variant Variant::get(const char* key) const {
     if (!isMap()) {
         return Variant();
@@ -741,6 +777,13 @@ Variant Variant::get(const String& key) const {
     return value<VariantMap>().get(key);
 }
 
+Variant Variant::get(StringView key) const {
+    if (!isMap()) {
+        return Variant();
+    }
+    return value<VariantMap>().get(key);
+}
+
 bool Variant::has(const char* key) const {
     if (!isMap()) {
         return false;
@@ -755,6 +798,13 @@ bool Variant::has(const String& key) const {
     return value<VariantMap>().has(key);
 }
 
+bool Variant::has(StringView key) const {
+    if (!isMap()) {
+        return false;
+    }
+    return value<VariantMap>().has(key);
+}
+
 int Variant::size() const {
     switch (type()) {
     case Type::STRING:
@@ -793,13 +843,13 @@ String Variant::toJSON() const {
     return s;
 }
 
-Variant Variant::fromJSON(const char* json) {
-    return fromJSON(JSONValue::parseCopy(json));
+Variant Variant::fromJSON(const char* json, StringPool* keyPool) {
+    return fromJSON(JSONValue::parseCopy(json), keyPool);
 }
 
-Variant Variant::fromJSON(const JSONValue& val) {
+Variant Variant::fromJSON(const JSONValue& val, StringPool* keyPool) {
     Variant v;
-    int r = decodeFromJson(val, v);
+    int r = decodeFromJson(val, v, keyPool);
     if (r < 0) {
         return Variant();
     }
@@ -812,11 +862,11 @@ int encodeToCBOR(const Variant& var, Print& stream) {
     return 0;
 }
 
-int decodeFromCBOR(Variant& var, Stream& stream) {
+int decodeFromCBOR(Variant& var, Stream& stream, StringPool* keyPool) {
     DecodingStream s(stream);
     CborHead h;
     CHECK(readCborHead(s, h));
-    CHECK(decodeFromCbor(s, h, var));
+    CHECK(decodeFromCbor(s, h, var, keyPool));
     return 0;
 }
 
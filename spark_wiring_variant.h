@@ -26,6 +26,9 @@
 #include "spark_wiring_string.h"
 #include "spark_wiring_vector.h"
 #include "spark_wiring_map.h"
+#include "spark_wiring_hash_map.h"
+#include "spark_wiring_allocator.h"
+#include "spark_wiring_string_pool.h"
 
 #include "debug.h"
 
@@ -44,15 +47,40 @@ using spark::JSONValue;
 
 class Variant;
 
+} // namespace particle
+
+// All alternative types of Variant are trivially relocatable
+template<>
+struct spark::IsTriviallyRelocatable<particle::Variant>: std::true_type {
+};
+
+// Define PARTICLE_VARIANT_ALLOCATOR to allocate memory for arrays and maps of Variant values using
+// a different allocator, e.g. spark::ArenaAllocator. The macro changes the VariantArray and
+// VariantMap types, so it needs to be defined the same way for the library and the code using it
+#ifndef PARTICLE_VARIANT_ALLOCATOR
+#define PARTICLE_VARIANT_ALLOCATOR ::spark::DefaultAllocator
+#endif
+
+namespace particle {
+
 /**
  * An array of `Variant` values.
  */
-typedef Vector<Variant> VariantArray;
+typedef Vector<Variant, PARTICLE_VARIANT_ALLOCATOR> VariantArray;
 
 /**
  * A map of named `Variant` values.
+ *
+ * Define PARTICLE_VARIANT_HASH_MAP to use `HashMap` instead of `Map`. Note that the entries of a
+ * `HashMap` are stored in insertion order rather than sorted by key. The macro changes the layout
+ * of `Variant` and `LedgerData`, so it needs to be defined the same way for the library and the
+ * code using it.
  */
-typedef Map<String, Variant> VariantMap;
+#ifdef PARTICLE_VARIANT_HASH_MAP
+typedef HashMap<String, Variant, Hash<String>, std::equal_to<>, PARTICLE_VARIANT_ALLOCATOR> VariantMap;
+#else
+typedef Map<String, Variant, std::less<String>, PARTICLE_VARIANT_ALLOCATOR> VariantMap;
+#endif
 
 namespace detail {
 
@@ -563,6 +591,7 @@ public:
     bool set(const char* key, Variant val);
     bool set(const String& key, Variant val);
     bool set(String&& key, Variant val);
+    bool set(StringView key, Variant val);
     ///@}
 
     ///@{
@@ -576,6 +605,7 @@ public:
      */
     bool remove(const char* key);
     bool remove(const String& key);
+    bool remove(StringView key);
     ///@}
 
     ///@{
@@ -594,6 +624,7 @@ public:
      */
     Variant get(const char* key) const;
     Variant get(const String& key) const;
+    Variant get(StringView key) const;
     ///@}
 
     ///@{
@@ -607,6 +638,7 @@ public:
      */
     bool has(const char* key) const;
     bool has(const String& key) const;
+    bool has(StringView key) const;
     ///@}
     ///@}
 
@@ -739,17 +771,19 @@ public:
      * Parse a variant from JSON.
      *
      * @param json JSON document.
+     * @param keyPool Pool used to intern the keys of the decoded maps, or `nullptr`.
      * @return Variant.
      */
-    static Variant fromJSON(const char* json);
+    static Variant fromJSON(const char* json, StringPool* keyPool = nullptr);
 
     /**
      * Convert a JSON value to a variant.
      *
      * @param val JSON value.
+     * @param keyPool Pool used to intern the keys of the decoded maps, or `nullptr`.
      * @return Variant.
      */
-    static Variant fromJSON(const JSONValue& val);
+    static Variant fromJSON(const JSONValue& val, StringPool* keyPool = nullptr);
 
     friend void swap(Variant& var1, Variant& var2) {
         using std::swap; // For ADL
@@ -1049,10 +1083,14 @@ int encodeToCBOR(const Variant& var, Print& stream);
 /**
  * Decode a variant from CBOR.
  *
+ * Decoding a large number of maps with the same keys, such as an array of records, allocates
+ * memory for each copy of each key unless a key pool is used.
+ *
  * @param[out] var Variant.
  * @param stream Input stream.
+ * @param keyPool Pool used to intern the keys of the decoded maps, or `nullptr`.
  * @return 0 on success, otherwise an error code defined by `Error::Type`.
  */
-int decodeFromCBOR(Variant& var, Stream& stream);
+int decodeFromCBOR(Variant& var, Stream& stream, StringPool* keyPool = nullptr);
 
 } // namespace particle
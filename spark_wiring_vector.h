@@ -23,6 +23,7 @@
 #include <type_traits>
 #include <iterator>
 #include <utility>
+#include <limits>
 
 // GCC didn't support std::is_trivially_copyable trait until 5.1.0
 #if defined(__GNUC__) && (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 < 50100)
@@ -38,16 +39,150 @@
 #define PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_COPYABLE(T) \
         typename EnableT = T, typename std::enable_if<!PARTICLE_VECTOR_TRIVIALLY_COPYABLE_TRAIT<EnableT>::value, int>::type = 0
 
+#define PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_RELOCATABLE(T) \
+        typename EnableT = T, typename std::enable_if<::spark::IsTriviallyRelocatable<EnableT>::value, int>::type = 0
+
+#define PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_RELOCATABLE(T) \
+        typename EnableT = T, typename std::enable_if<!::spark::IsTriviallyRelocatable<EnableT>::value, int>::type = 0
+
 namespace spark {
 
+/**
+ * Trait indicating that an object can be moved to a different memory location by copying its bytes.
+ *
+ * Containers use `realloc()` and `memmove()` to move elements of such types instead of calling
+ * their move constructors and destructors. All trivially copyable types are trivially relocatable.
+ * The trait can be specialized for other types that don't store pointers to themselves and don't
+ * have their addresses registered anywhere else.
+ */
+template<typename T>
+struct IsTriviallyRelocatable: std::integral_constant<bool, PARTICLE_VECTOR_TRIVIALLY_COPYABLE_TRAIT<T>::value> {
+};
+
+template<typename T>
+struct IsTriviallyRelocatable<const T>: IsTriviallyRelocatable<T> {
+};
+
+template<typename T1, typename T2>
+struct IsTriviallyRelocatable<std::pair<T1, T2>>: std::integral_constant<bool, IsTriviallyRelocatable<T1>::value &&
+        IsTriviallyRelocatable<T2>::value> {
+};
+
 struct DefaultAllocator {
     static void* malloc(size_t size);
     static void* realloc(void* ptr, size_t size);
     static void free(void* ptr);
 };
 
+namespace detail {
+
+// Capacity growth policy used by Vector when an element is inserted into a full array. By default,
+// the capacity is increased by a factor of 1.5 so that appending elements one by one takes amortized
+// constant time. An allocator can override this by providing a static method with the following
+// signature: `int growCapacity(int capacity, int required)`
+template<typename AllocatorT, typename EnableT = void>
+struct VectorGrowthPolicy {
+    static int capacity(int capacity, int required) {
+        if (capacity > std::numeric_limits<int>::max() / 3 * 2) {
+            return required;
+        }
+        const int n = capacity + (capacity + 1) / 2;
+        return (n > required) ? n : required;
+    }
+};
+
+template<typename AllocatorT>
+struct VectorGrowthPolicy<AllocatorT, decltype((void)AllocatorT::growCapacity(0, 0))> {
+    static int capacity(int capacity, int required) {
+        const int n = AllocatorT::growCapacity(capacity, required);
+        return (n > required) ? n : required;
+    }
+};
+
+// Helper methods for constructing, moving and destroying array elements
+template<typename T>
+struct VectorElements {
+    // TODO: Use standard algorithms like std::uninitialized_copy() and std::uninitialized_move()
+    // instead of custom implementations
+    template<PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_COPYABLE(T)>
+    static void copy(T* dest, const T* p, const T* end) {
+        ::memcpy(dest, p, (end - p) * sizeof(T));
+    }
+
+    template<PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_COPYABLE(T)>
+    static void copy(T* dest, const T* p, const T* end) {
+        for (; p != end; ++p, ++dest) {
+            new(dest) T(*p);
+        }
+    }
+
+    template<typename IteratorT>
+    static void copy(IteratorT dest, IteratorT it, IteratorT end) {
+        for (; it != end; ++it, ++dest) {
+            new(dest) T(*it);
+        }
+    }
+
+    template<PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_RELOCATABLE(T)>
+    static void move(T* dest, const T* p, const T* end) {
+        ::memmove((void*)dest, (const void*)p, (end - p) * sizeof(T));
+    }
+
+    template<PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_RELOCATABLE(T)>
+    static void move(T* dest, T* p, T* end) {
+        if (dest > p && dest < end) {
+            // Move elements in reverse order
+            --p;
+            --end;
+            dest += end - p - 1;
+            for (; end != p; --end, --dest) {
+                new(dest) T(std::move(*end));
+                end->~T();
+            }
+        } else if (dest != p) {
+            for (; p != end; ++p, ++dest) {
+                new(dest) T(std::move(*p));
+                p->~T();
+            }
+        }
+    }
+
+    static T* find(T* p, const T* end, const T& value) {
+        for (; p != end; ++p) {
+            if (*p == value) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    static T* rfind(T* p, const T* end, const T& value) {
+        for (; p != end; --p) {
+            if (*p == value) {
+                return p;
+            }
+        }
+        return nullptr;
+    }
+
+    template<typename... ArgsT>
+    static void construct(T* p, const T* end, ArgsT&&... args) {
+        for (; p != end; ++p) {
+            new(p) T(std::forward<ArgsT>(args)...);
+        }
+    }
+
+    static void destruct(T* p, const T* end) {
+        for (; p != end; ++p) {
+            p->~T();
+        }
+    }
+};
+
+} // namespace detail
+
 template<typename T, typename AllocatorT = DefaultAllocator>
-class Vector {
+class Vector: private detail::VectorElements<T> {
 public:
     typedef T ValueType;
     typedef AllocatorT AllocatorType;
@@ -136,7 +271,21 @@ private:
     T* data_;
     int size_, capacity_;
 
-    template<PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_COPYABLE(T)>
+    using detail::VectorElements<T>::copy;
+    using detail::VectorElements<T>::move;
+    using detail::VectorElements<T>::find;
+    using detail::VectorElements<T>::rfind;
+    using detail::VectorElements<T>::construct;
+    using detail::VectorElements<T>::destruct;
+
+    bool grow(int n) {
+        if (n <= capacity_) {
+            return true;
+        }
+        return realloc(detail::VectorGrowthPolicy<AllocatorT>::capacity(capacity_, n));
+    }
+
+    template<PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_RELOCATABLE(T)>
     bool realloc(int n) {
         T* d = nullptr;
         if (n > 0) {
@@ -152,7 +301,7 @@ private:
         return true;
     }
 
-    template<PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_COPYABLE(T)>
+    template<PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_RELOCATABLE(T)>
     bool realloc(int n) {
         T* d = nullptr;
         if (n > 0) {
@@ -168,82 +317,6 @@ private:
         return true;
     }
 
-    // TODO: Use standard algorithms like std::uninitialized_copy() and std::uninitialized_move()
-    // instead of custom implementations
-    template<PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_COPYABLE(T)>
-    static void copy(T* dest, const T* p, const T* end) {
-        ::memcpy(dest, p, (end - p) * sizeof(T));
-    }
-
-    template<PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_COPYABLE(T)>
-    static void copy(T* dest, const T* p, const T* end) {
-        for (; p != end; ++p, ++dest) {
-            new(dest) T(*p);
-        }
-    }
-
-    template<typename IteratorT>
-    static void copy(IteratorT dest, IteratorT it, IteratorT end) {
-        for (; it != end; ++it, ++dest) {
-            new(dest) T(*it);
-        }
-    }
-
-    template<PARTICLE_VECTOR_ENABLE_IF_TRIVIALLY_COPYABLE(T)>
-    static void move(T* dest, const T* p, const T* end) {
-        ::memmove(dest, p, (end - p) * sizeof(T));
-    }
-
-    template<PARTICLE_VECTOR_ENABLE_IF_NOT_TRIVIALLY_COPYABLE(T)>
-    static void move(T* dest, T* p, T* end) {
-        if (dest > p && dest < end) {
-            // Move elements in reverse order
-            --p;
-            --end;
-            dest += end - p - 1;
-            for (; end != p; --end, --dest) {
-                new(dest) T(std::move(*end));
-                end->~T();
-            }
-        } else if (dest != p) {
-            for (; p != end; ++p, ++dest) {
-                new(dest) T(std::move(*p));
-                p->~T();
-            }
-        }
-    }
-
-    static T* find(T* p, const T* end, const T& value) {
-        for (; p != end; ++p) {
-            if (*p == value) {
-                return p;
-            }
-        }
-        return nullptr;
-    }
-
-    static T* rfind(T* p, const T* end, const T& value) {
-        for (; p != end; --p) {
-            if (*p == value) {
-                return p;
-            }
-        }
-        return nullptr;
-    }
-
-    template<typename... ArgsT>
-    static void construct(T* p, const T* end, ArgsT&&... args) {
-        for (; p != end; ++p) {
-            new(p) T(std::forward<ArgsT>(args)...);
-        }
-    }
-
-    static void destruct(T* p, const T* end) {
-        for (; p != end; ++p) {
-            p->~T();
-        }
-    }
-
     template<typename V, typename A>
     friend void swap(Vector<V, A>& vector, Vector<V, A>& vector2);
 };
@@ -251,11 +324,16 @@ private:
 template<typename T, typename AllocatorT>
 void swap(Vector<T, AllocatorT>& vector, Vector<T, AllocatorT>& vector2);
 
+template<typename T, typename AllocatorT>
+struct IsTriviallyRelocatable<Vector<T, AllocatorT>>: std::true_type {
+};
+
 } // spark
 
 namespace particle {
 
 using ::spark::Vector;
+using ::spark::IsTriviallyRelocatable;
 
 } // particle
 
@@ -374,7 +452,7 @@ inline bool spark::Vector<T, AllocatorT>::prepend(const Vector<T, AllocatorT> &v
 
 template<typename T, typename AllocatorT>
 inline bool spark::Vector<T, AllocatorT>::insert(int i, T value) {
-    if (size_ + 1 > capacity_ && !realloc(size_ + 1)) {
+    if (!grow(size_ + 1)) {
         return false;
     }
     T* const p = data_ + i;
@@ -386,7 +464,7 @@ inline bool spark::Vector<T, AllocatorT>::insert(int i, T value) {
 
 template<typename T, typename AllocatorT>
 inline bool spark::Vector<T, AllocatorT>::insert(int i, int n, const T& value) {
-    if (size_ + n > capacity_ && !realloc(size_ + n)) {
+    if (!grow(size_ + n)) {
         return false;
     }
     T* const p = data_ + i;
@@ -398,7 +476,7 @@ inline bool spark::Vector<T, AllocatorT>::insert(int i, int n, const T& value) {
 
 template<typename T, typename AllocatorT>
 inline bool spark::Vector<T, AllocatorT>::insert(int i, const T* values, int n) {
-    if (size_ + n > capacity_ && !realloc(size_ + n)) {
+    if (!grow(size_ + n)) {
         return false;
     }
     T* const p = data_ + i;
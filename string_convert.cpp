@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2026 Particle Industries, Inc.  All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "string_convert.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const char DIGIT_PAIRS[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+// Maximum number of digits in a 64-bit decimal number
+const size_t MAX_DECIMAL_LENGTH = 20;
+
+const char LOWER_DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+const char UPPER_DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+inline unsigned decimalLength(uint64_t value) {
+    unsigned n = 1;
+    for (;;) {
+        if (value < 10) {
+            return n;
+        }
+        if (value < 100) {
+            return n + 1;
+        }
+        if (value < 1000) {
+            return n + 2;
+        }
+        if (value < 10000) {
+            return n + 3;
+        }
+        value /= 10000;
+        n += 4;
+    }
+}
+
+// Writes the digits backwards, ending at the given position. 32-bit values are formatted separately
+// as 64-bit division is considerably slower on 32-bit platforms
+template<typename T>
+inline void writeDecimal(T value, char* end) {
+    while (value >= 100) {
+        const unsigned i = (unsigned)(value % 100) * 2;
+        value /= 100;
+        *--end = DIGIT_PAIRS[i + 1];
+        *--end = DIGIT_PAIRS[i];
+    }
+    if (value >= 10) {
+        const unsigned i = (unsigned)value * 2;
+        *--end = DIGIT_PAIRS[i + 1];
+        *--end = DIGIT_PAIRS[i];
+    } else {
+        *--end = '0' + (char)value;
+    }
+}
+
+size_t formatDecimal(uint64_t value, char* buf) {
+    const unsigned n = decimalLength(value);
+    if (value <= UINT32_MAX) {
+        writeDecimal((uint32_t)value, buf + n);
+    } else {
+        writeDecimal(value, buf + n);
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+size_t formatPowerOfTwo(uint64_t value, char* buf, unsigned shift, const char* digits) {
+    const unsigned bits = 64 - __builtin_clzll(value | 1);
+    const unsigned n = (bits + shift - 1) / shift;
+    const unsigned mask = (1u << shift) - 1;
+    char* p = buf + n;
+    *p = '\0';
+    do {
+        *--p = digits[value & mask];
+        value >>= shift;
+    } while (p != buf);
+    return n;
+}
+
+size_t formatOther(uint64_t value, char* buf, unsigned base, const char* digits) {
+    char tmp[particle::detail::MAX_INTEGER_STRING_LENGTH];
+    char* const end = tmp + sizeof(tmp);
+    char* p = end;
+    do {
+        const uint64_t q = value / base;
+        *--p = digits[value - q * base];
+        value = q;
+    } while (value);
+    const size_t n = end - p;
+    memcpy(buf, p, n);
+    buf[n] = '\0';
+    return n;
+}
+
+// Writes the fixed-point representation of a number to a buffer that may be too small for it,
+// keeping track of the digits that need to change if the number is rounded up
+class FixedPointWriter {
+public:
+    FixedPointWriter(char* buf, size_t size) :
+            buf_(buf),
+            size_(size),
+            len_(0),
+            firstDigit_(0),
+            lastNon9_(NO_DIGIT),
+            lastDigit_(0) {
+    }
+
+    void sign() {
+        put('-');
+        firstDigit_ = len_;
+    }
+
+    void digit(unsigned d) {
+        if (d != 9) {
+            lastNon9_ = len_;
+        }
+        lastDigit_ = d;
+        put('0' + d);
+    }
+
+    void zeros(size_t count) {
+        while (count--) {
+            digit(0);
+        }
+    }
+
+    void point() {
+        put('.');
+    }
+
+    unsigned lastDigit() const {
+        return lastDigit_;
+    }
+
+    void roundUp();
+
+    size_t finish() {
+        if (size_) {
+            buf_[stored()] = '\0';
+        }
+        return len_;
+    }
+
+private:
+    static const size_t NO_DIGIT = (size_t)-1;
+
+    char* buf_;
+    size_t size_;
+    size_t len_;
+    size_t firstDigit_;
+    size_t lastNon9_;
+    unsigned lastDigit_;
+
+    void put(char c) {
+        if (len_ + 1 < size_) {
+            buf_[len_] = c;
+        }
+        ++len_;
+    }
+
+    size_t stored() const {
+        return (len_ + 1 < size_) ? len_ : (size_ ? size_ - 1 : 0);
+    }
+};
+
+void FixedPointWriter::roundUp() {
+    size_t i = 0;
+    if (lastNon9_ != NO_DIGIT) {
+        // Increment the last digit that is not 9 and replace the 9s following it with 0s
+        if (lastNon9_ < stored()) {
+            ++buf_[lastNon9_];
+        }
+        i = lastNon9_ + 1;
+    } else {
+        // All digits are 9s: replace them with 0s and insert a 1 in front of them
+        ++len_;
+        const size_t n = stored();
+        if (firstDigit_ < n) {
+            memmove(buf_ + firstDigit_ + 1, buf_ + firstDigit_, n - firstDigit_ - 1);
+            buf_[firstDigit_] = '1';
+        }
+        i = firstDigit_ + 1;
+    }
+    const size_t n = stored();
+    for (; i < n; ++i) {
+        if (buf_[i] != '.') {
+            buf_[i] = '0';
+        }
+    }
+}
+
+// Writes the integer part of a number that doesn't fit in 64 bits, m * 2^e
+void writeBigInteger(FixedPointWriter& w, uint64_t m, unsigned e) {
+    // The largest double is less than 2^1024
+    const unsigned MAX_WORDS = 1024 / 32;
+    uint32_t words[MAX_WORDS + 1] = {};
+    unsigned n = e / 32;
+    const unsigned shift = e % 32;
+    words[n] = (uint32_t)(m << shift);
+    words[n + 1] = (uint32_t)((m << shift) >> 32);
+    words[n + 2] = shift ? (uint32_t)(m >> (64 - shift)) : 0;
+    n += 3;
+    while (n > 0 && !words[n - 1]) {
+        --n;
+    }
+    // Divide the number by 10^9 to get groups of 9 digits, starting from the least significant one
+    const uint32_t GROUP_DIVISOR = 1000000000;
+    const unsigned GROUP_DIGITS = 9;
+    uint32_t groups[(1024 * 30103 / 100000) / GROUP_DIGITS + 2]; // log10(2) = 0.30103
+    unsigned groupCount = 0;
+    while (n > 0) {
+        uint64_t r = 0;
+        for (unsigned i = n; i > 0; --i) {
+            const uint64_t v = (r << 32) | words[i - 1];
+            words[i - 1] = (uint32_t)(v / GROUP_DIVISOR);
+            r = v % GROUP_DIVISOR;
+        }
+        groups[groupCount++] = (uint32_t)r;
+        while (n > 0 && !words[n - 1]) {
+            --n;
+        }
+    }
+    char buf[GROUP_DIGITS + 1];
+    size_t len = formatDecimal(groups[groupCount - 1], buf);
+    for (size_t i = 0; i < len; ++i) {
+        w.digit(buf[i] - '0');
+    }
+    for (unsigned i = groupCount - 1; i > 0; --i) {
+        len = formatDecimal(groups[i - 1], buf);
+        w.zeros(GROUP_DIGITS - len);
+        for (size_t j = 0; j < len; ++j) {
+            w.digit(buf[j] - '0');
+        }
+    }
+}
+
+// Writes the fractional part of a number, f / 2^k, and returns a value that is negative, zero, or
+// positive if the remainder after the last digit is less than, equal to, or greater than one half
+// of the last digit's unit
+int writeFraction(FixedPointWriter& w, uint64_t f, unsigned k, unsigned precision) {
+    if (!f) {
+        w.zeros(precision);
+        return -1;
+    }
+    if (k <= 60) {
+        // f * 10 fits in 64 bits
+        const uint64_t mask = ((uint64_t)1 << k) - 1;
+        while (precision > 0) {
+            f *= 10;
+            w.digit(f >> k);
+            f &= mask;
+            --precision;
+            if (!f) {
+                w.zeros(precision);
+                return -1;
+            }
+        }
+        const uint64_t half = (uint64_t)1 << (k - 1);
+        return (f < half) ? -1 : (f > half) ? 1 : 0;
+    }
+    // Store the fraction as a big number so that the binary point is at a word boundary. Multiplying
+    // it by 10 then moves the next decimal digit out of the most significant word
+    const unsigned MAX_WORDS = (1074 + 31) / 32 + 1; // The smallest double is 2^-1074
+    uint32_t words[MAX_WORDS + 1] = {};
+    const unsigned n = (k + 31) / 32;
+    const unsigned s = n * 32 - k; // f is less than 2^53, so f << s spans at most 3 words
+    words[0] = (uint32_t)(f << s);
+    words[1] = (uint32_t)((f << s) >> 32);
+    words[2] = s ? (uint32_t)(f >> (64 - s)) : 0;
+    unsigned lo = 0; // Index of the least significant non-zero word
+    while (!words[lo]) {
+        ++lo;
+    }
+    while (precision > 0) {
+        uint32_t carry = 0;
+        for (unsigned i = lo; i < n; ++i) {
+            const uint64_t v = (uint64_t)words[i] * 10 + carry;
+            words[i] = (uint32_t)v;
+            carry = (uint32_t)(v >> 32);
+        }
+        w.digit(carry);
+        --precision;
+        while (lo < n && !words[lo]) {
+            ++lo;
+        }
+        if (lo == n) {
+            w.zeros(precision);
+            return -1;
+        }
+    }
+    const uint32_t top = words[n - 1];
+    if (top != 0x80000000u) {
+        return (top < 0x80000000u) ? -1 : 1;
+    }
+    return (lo < n - 1) ? 1 : 0;
+}
+
+// The bytes of a 64-bit word are checked in parallel. Their high bits are cleared first, so that
+// adding a constant to one byte never carries into the next one
+const uint64_t SWAR_ONES = 0x0101010101010101ull;
+const uint64_t SWAR_HIGH_BITS = 0x8080808080808080ull;
+
+// Bit that differs between the lower and upper case forms of an ASCII letter
+const unsigned char CASE_BIT = 0x20;
+
+inline bool isInRange(unsigned char c, char first, char last) {
+    return (unsigned char)(c - first) <= (unsigned char)(last - first);
+}
+
+inline unsigned char foldCase(unsigned char c) {
+    return isInRange(c, 'A', 'Z') ? (c | CASE_BIT) : c;
+}
+
+// Returns a word that has CASE_BIT set in each byte of w that is in the range [first, last]. The
+// range must be within the ASCII range
+inline uint64_t caseBits(uint64_t w, char first, char last) {
+    const uint64_t low = w & ~SWAR_HIGH_BITS;
+    const uint64_t geFirst = low + SWAR_ONES * (0x80 - first);
+    const uint64_t gtLast = low + SWAR_ONES * (0x7f - last);
+    return ((geFirst & ~gtLast & ~w) & SWAR_HIGH_BITS) >> 2;
+}
+
+#if defined(__SSE2__)
+
+inline __m128i caseBits(__m128i v, char first, char last) {
+    // Move the range to the bottom of the signed range so that a single signed comparison
+    // checks both of its ends
+    const __m128i t = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - first)));
+    const __m128i in = _mm_cmplt_epi8(t, _mm_set1_epi8((char)(last - first - 0x7f)));
+    return _mm_and_si128(in, _mm_set1_epi8(CASE_BIT));
+}
+
+#endif // defined(__SSE2__)
+
+// Flips the case of the characters in the range [first, last]
+void flipCase(char* s, size_t n, char first, char last) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(s + i));
+        _mm_storeu_si128((__m128i*)(s + i), _mm_xor_si128(v, caseBits(v, first, last)));
+    }
+#endif
+    for (; i + 8 <= n; i += 8) {
+        uint64_t w;
+        memcpy(&w, s + i, 8);
+        w ^= caseBits(w, first, last);
+        memcpy(s + i, &w, 8);
+    }
+    for (; i < n; ++i) {
+        if (isInRange(s[i], first, last)) {
+            s[i] ^= CASE_BIT;
+        }
+    }
+}
+
+} // namespace
+
+namespace particle {
+
+namespace detail {
+
+size_t formatUnsigned(unsigned long long value, char* buf, unsigned base, bool upperCase) {
+    if (base == 10 || base < 2 || base > 36) {
+        return formatDecimal(value, buf);
+    }
+    const char* const digits = upperCase ? UPPER_DIGITS : LOWER_DIGITS;
+    if ((base & (base - 1)) == 0) {
+        return formatPowerOfTwo(value, buf, __builtin_ctz(base), digits);
+    }
+    return formatOther(value, buf, base, digits);
+}
+
+size_t formatSigned(long long value, char* buf, unsigned base, bool upperCase) {
+    if (value < 0) {
+        *buf = '-';
+        // Negate in the unsigned domain to handle the minimum value of the type
+        return formatUnsigned(0ull - (unsigned long long)value, buf + 1, base, upperCase) + 1;
+    }
+    return formatUnsigned(value, buf, base, upperCase);
+}
+
+size_t formatDouble(double value, unsigned precision, char* buf, size_t size) {
+    uint64_t bits = 0;
+    static_assert(sizeof(bits) == sizeof(value), "Unsupported double format");
+    memcpy(&bits, &value, sizeof(bits));
+    const bool negative = bits >> 63;
+    const unsigned exp = (bits >> 52) & 0x7ff;
+    uint64_t m = bits & (((uint64_t)1 << 52) - 1);
+    FixedPointWriter w(buf, size);
+    if (exp == 0x7ff) {
+        const char* const str = m ? "nan" : (negative ? "-inf" : "inf");
+        const size_t len = strlen(str);
+        if (size) {
+            const size_t n = (len < size) ? len : size - 1;
+            memcpy(buf, str, n);
+            buf[n] = '\0';
+        }
+        return len;
+    }
+    // value = m * 2^e
+    int e = 0;
+    if (exp) {
+        m |= (uint64_t)1 << 52;
+        e = (int)exp - 1075;
+    } else {
+        e = -1074;
+    }
+    if (negative) {
+        w.sign();
+    }
+    int r = -1;
+    if (e >= 0) {
+        if (e <= 11) {
+            char digits[MAX_DECIMAL_LENGTH + 1];
+            const size_t n = formatDecimal(m << e, digits);
+            for (size_t i = 0; i < n; ++i) {
+                w.digit(digits[i] - '0');
+            }
+        } else {
+            writeBigInteger(w, m, e);
+        }
+        if (precision > 0) {
+            w.point();
+            w.zeros(precision);
+        }
+    } else {
+        const unsigned k = -e;
+        char digits[MAX_DECIMAL_LENGTH + 1];
+        const size_t n = formatDecimal((k < 64) ? (m >> k) : 0, digits);
+        for (size_t i = 0; i < n; ++i) {
+            w.digit(digits[i] - '0');
+        }
+        if (precision > 0) {
+            w.point();
+        }
+        const uint64_t f = (k < 64) ? (m & (((uint64_t)1 << k) - 1)) : m;
+        r = writeFraction(w, f, k, precision);
+    }
+    if (r > 0 || (r == 0 && (w.lastDigit() & 1))) {
+        w.roundUp();
+    }
+    return w.finish();
+}
+
+void toLowerCaseAscii(char* str, size_t size) {
+    flipCase(str, size, 'A', 'Z');
+}
+
+void toUpperCaseAscii(char* str, size_t size) {
+    flipCase(str, size, 'a', 'z');
+}
+
+int compareIgnoreCaseAscii(const char* str1, const char* str2, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(str1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(str2 + i));
+        a = _mm_or_si128(a, caseBits(a, 'A', 'Z'));
+        b = _mm_or_si128(b, caseBits(b, 'A', 'Z'));
+        const unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xffff;
+        if (mask) {
+            i += __builtin_ctz(mask);
+            return (int)foldCase(str1[i]) - (int)foldCase(str2[i]);
+        }
+    }
+#endif
+    // Skip the equal words, the first difference is then located by the loop below
+    for (; i + 8 <= size; i += 8) {
+        uint64_t a, b;
+        memcpy(&a, str1 + i, 8);
+        memcpy(&b, str2 + i, 8);
+        if ((a | caseBits(a, 'A', 'Z')) != (b | caseBits(b, 'A', 'Z'))) {
+            break;
+        }
+    }
+    for (; i < size; ++i) {
+        const int d = (int)foldCase(str1[i]) - (int)foldCase(str2[i]);
+        if (d) {
+            return d;
+        }
+    }
+    return 0;
+}
+
+} // namespace detail
+
+} // namespace particle
+
+using particle::detail::formatInteger;
+
+extern "C"
+char *itoa(int value, char *str, int base) {
+    formatInteger(value, str, base);
+    return str;
+}
+
+extern "C"
+char *utoa(unsigned int value, char *str, int base) {
+    formatInteger(value, str, base);
+    return str;
+}
+
+extern "C"
+char *ltoa(long value, char *str, int base) {
+    formatInteger(value, str, base);
+    return str;
+}
+
+extern "C"
+char *ultoa(unsigned long value, char *str, int base, char pad) {
+    const size_t n = formatInteger(value, str, base);
+    if (pad > 0 && n < (size_t)pad) {
+        const size_t zeros = pad - n;
+        memmove(str + zeros, str, n + 1);
+        memset(str, '0', zeros);
+    }
+    return str;
+}
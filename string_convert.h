@@ -2,6 +2,8 @@
 #ifndef STRING_CONVERT_H
 #define	STRING_CONVERT_H
 
+#include <stddef.h>
+
 #ifdef	__cplusplus
 extern "C" {
 #endif
@@ -9,7 +11,7 @@ extern "C" {
 //convert long to string
 char *ltoa(long N, char *str, int base);
 
-//convert unsigned long to string
+//convert unsigned long to string, padding it with zeros to at least pad digits
 char* ultoa(unsigned long a, char* buffer, int radix, char pad=1);
 
 //convert unsigned int to string
@@ -24,5 +26,62 @@ char* itoa(int a, char* buffer, int radix);
 }
 #endif
 
-#endif	/* STRING_CONVERT_H */
+#ifdef	__cplusplus
+
+#include <type_traits>
+
+namespace particle {
+
+namespace detail {
+
+// Maximum number of characters produced by the integer formatting functions below, not counting
+// the '\0': 64 binary digits and a sign
+const size_t MAX_INTEGER_STRING_LENGTH = 65;
+
+// Format an integer in the given base (2-36, other values are treated as 10). The buffer must have
+// room for MAX_INTEGER_STRING_LENGTH + 1 characters. The result is null-terminated and its length
+// is returned. Decimal digits are generated two at a time using a lookup table
+size_t formatUnsigned(unsigned long long value, char* buf, unsigned base = 10, bool upperCase = false);
+
+// Same as formatUnsigned() but prefixes the absolute value with a minus sign if it's negative
+size_t formatSigned(long long value, char* buf, unsigned base = 10, bool upperCase = false);
+
+// Format an integer the way itoa() does: signed types are formatted with a sign in base 10, and as
+// the two's complement of the value in other bases
+template<typename T>
+inline size_t formatInteger(T value, char* buf, unsigned base = 10, bool upperCase = false) {
+    static_assert(std::is_integral<T>::value, "T must be an integer type");
+    if (std::is_signed<T>::value && (base == 10 || base < 2 || base > 36)) {
+        return formatSigned(value, buf, 10, upperCase);
+    }
+    return formatUnsigned((typename std::make_unsigned<T>::type)value, buf, base, upperCase);
+}
 
+// Format a floating point number in fixed-point notation with the given number of digits after the
+// decimal point. The digits are generated exactly from the binary value, and the last digit is
+// rounded half to even, which matches the output of printf("%.*f"), including the sign of negative
+// zero. NaN and infinite values are formatted as "nan", "inf" and "-inf". At most size - 1 characters are written to the buffer,
+// followed by a '\0'. Similarly to snprintf(), the length of the entire result is returned
+size_t formatDouble(double value, unsigned precision, char* buf, size_t size);
+
+// Convert the ASCII letters in a buffer to lower or upper case. Other characters, including
+// non-ASCII ones, are left unchanged. The buffer is processed a word or a SIMD register at a time
+void toLowerCaseAscii(char* str, size_t size);
+void toUpperCaseAscii(char* str, size_t size);
+
+// Compare two buffers of the same size as if their ASCII letters were in lower case. Similarly to
+// strncasecmp(), a negative, zero or positive value is returned
+int compareIgnoreCaseAscii(const char* str1, const char* str2, size_t size);
+
+// Returns true for the characters that isspace() accepts in the "C" locale
+inline bool isSpaceAscii(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+} // namespace detail
+
+} // namespace particle
+
+#endif
+
+#endif	/* STRING_CONVERT_H */
@@ -0,0 +1,102 @@
+#include "Particle.h"
+#include "string_convert.h"
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+// make test_format_double && ./test_format_double
+//
+// Compares the output of formatDouble() with printf("%.*f") for special and random values, and
+// checks that values printed with 17 significant digits can be parsed back with strtod()
+
+using particle::detail::formatDouble;
+
+namespace {
+
+int failures = 0;
+
+std::string expected(double value, unsigned precision) {
+    const int n = snprintf(nullptr, 0, "%.*f", (int)precision, value);
+    std::string s(n, '\0');
+    snprintf(&s[0], n + 1, "%.*f", (int)precision, value);
+    return s;
+}
+
+void check(double value, unsigned precision) {
+    const std::string exp = expected(value, precision);
+    std::vector<char> buf(exp.size() + 2, 'Z');
+    // Full buffer and truncated buffers of various sizes
+    for (size_t size: { exp.size() + 1, exp.size(), exp.size() / 2, (size_t)1, (size_t)0 }) {
+        std::fill(buf.begin(), buf.end(), 'Z');
+        const size_t n = formatDouble(value, precision, buf.data(), size);
+        const size_t len = size ? std::min(size - 1, exp.size()) : 0;
+        if (n != exp.size() || (size && (memcmp(buf.data(), exp.data(), len) != 0 || buf[len] != '\0')) ||
+                buf[size] != 'Z') {
+            printf("%a, precision %u, buffer size %u: expected \"%s\", got \"%.*s\"\n", value, precision,
+                    (unsigned)size, exp.c_str(), (int)len, buf.data());
+            ++failures;
+            return;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::mt19937_64 rng(1);
+    const double specials[] = { 0.0, -0.0, 0.5, 1.5, 2.5, -0.5, 0.125, 9.5, 99.5, 999.9999, 9.995, 0.05,
+            1e-300, 5e-324, DBL_MIN, DBL_MAX, -DBL_MAX, 1e22, 1e23, 123456789012345678.0, 4294967296.0,
+            1.0 / 3, 2.0 / 3, 0.1, 0.7, 1e15 + 0.5, 18446744073709551615.0, 9223372036854775808.0 };
+    for (double v: specials) {
+        for (unsigned p: { 0, 1, 2, 3, 6, 10, 17, 20, 40, 255, 400, 1100 }) {
+            check(v, p);
+        }
+    }
+    for (int i = 0; i < 100000; ++i) {
+        double v = 0;
+        if (i % 3 == 0) {
+            // Any finite value
+            const uint64_t bits = rng();
+            memcpy(&v, &bits, sizeof(v));
+            if (!std::isfinite(v)) {
+                continue;
+            }
+        } else if (i % 3 == 1) {
+            v = std::ldexp((double)(rng() >> 11), (int)(rng() % 140) - 100);
+        } else {
+            // Exact ties
+            v = (double)(int64_t)(rng() % 2000000 - 1000000) / (1 << (rng() % 12));
+        }
+        check(v, (i % 50 == 0) ? rng() % 1100 : rng() % 25);
+    }
+    // Round trip
+    for (int i = 0; i < 100000; ++i) {
+        const double v = std::ldexp((double)(rng() >> 11) / ((uint64_t)1 << 53), (int)(rng() % 100) - 40);
+        int p = 16 - (int)std::floor(std::log10(v));
+        if (p < 0) {
+            p = 0;
+        }
+        const String s(v, p);
+        if (strtod(s.c_str(), nullptr) != v) {
+            printf("%a: \"%s\" doesn't round-trip\n", v, s.c_str());
+            ++failures;
+        }
+    }
+    // Print::printFloat() with a result that doesn't fit in its stack buffer
+    String s;
+    particle::OutputStringStream out(s);
+    out.print(-DBL_MAX, 255);
+    if (s != expected(-DBL_MAX, 255).c_str()) {
+        printf("printFloat(-DBL_MAX, 255): got \"%s\"\n", s.c_str());
+        ++failures;
+    }
+    if (failures) {
+        printf("%d failures\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}